@@ -22,11 +22,20 @@ buttons.c
 * REVISION HISTORY
 ******************************************************************************
 * 11/21/2025      :	Created file
+* 12/28/2025      :	ISRs post EV_BUTTON to the event loop
+* 12/29/2025      :	Waits for a press in pm_idle instead of spinning
+* 12/30/2025      :	EXTI handlers are a profiling zone
 ******************************************************************************
 */
 
 #include "buttons.h"
 #include "main.h"
+#include "persist.h"
+#include "evloop.h"
+#include "delay.h"
+#include "swtimer.h"
+#include "lowpower.h"
+#include "prof.h"
 
 volatile uint8_t g_button_pressed_flag = 0;
 volatile uint8_t g_button_color_flag   = 0;
@@ -186,49 +195,62 @@ void buttons_exti_init(void) {
  */
 // EXTI line 3 -> PB3 (WHITE)
 void EXTI3_IRQHandler(void) {
+   PROF_BEGIN(PROF_EXTI);
    if (EXTI->PR1 & EXTI_PR1_PIF3) {
       EXTI->PR1 = EXTI_PR1_PIF3;     // clear pending
       g_button_pressed_flag = 1;
       g_button_color_flag   = WHITE_CODE;
       g_button_event_ready  = 1;
+      ev_post(EV_BUTTON, WHITE_CODE);
    }
+   PROF_END(PROF_EXTI);
 }
 
 // EXTI line 4 -> PB4 (GREEN)
 void EXTI4_IRQHandler(void) {
+   PROF_BEGIN(PROF_EXTI);
    if (EXTI->PR1 & EXTI_PR1_PIF4) {
       EXTI->PR1 = EXTI_PR1_PIF4;
       g_button_pressed_flag = 1;
       g_button_color_flag   = GREEN_CODE;
       g_button_event_ready  = 1;
+      ev_post(EV_BUTTON, GREEN_CODE);
    }
+   PROF_END(PROF_EXTI);
 }
 
 // EXTI lines 5..9 -> PB5 (YELLOW) is on this
 void EXTI9_5_IRQHandler(void) {
+   PROF_BEGIN(PROF_EXTI);
    if (EXTI->PR1 & EXTI_PR1_PIF5) {
       EXTI->PR1 = EXTI_PR1_PIF5;
       g_button_pressed_flag = 1;
       g_button_color_flag   = YELLOW_CODE;
       g_button_event_ready  = 1;
+      ev_post(EV_BUTTON, YELLOW_CODE);
    }
    // if you ever add more on lines 6..9, handle them here too
+   PROF_END(PROF_EXTI);
 }
 
 // EXTI lines 10..15 -> PB12 (BLUE), PB13 (RED)
 void EXTI15_10_IRQHandler(void) {
+   PROF_BEGIN(PROF_EXTI);
    if (EXTI->PR1 & EXTI_PR1_PIF12) {
       EXTI->PR1 = EXTI_PR1_PIF12;
       g_button_pressed_flag = 1;
       g_button_color_flag   = BLUE_CODE;
       g_button_event_ready  = 1;
+      ev_post(EV_BUTTON, BLUE_CODE);
    }
    if (EXTI->PR1 & EXTI_PR1_PIF13) {
       EXTI->PR1 = EXTI_PR1_PIF13;
       g_button_pressed_flag = 1;
       g_button_color_flag   = RED_CODE;
       g_button_event_ready  = 1;
+      ev_post(EV_BUTTON, RED_CODE);
    }
+   PROF_END(PROF_EXTI);
 }
 
 /*
@@ -242,22 +264,36 @@ void EXTI15_10_IRQHandler(void) {
  *
  *  returns: nothing
  */
+static void wake_up(void *arg) {
+   (void) arg;                       // the TIM2 interrupt ends pm_idle
+}
+
 // returns 1 on success, 0 on timeout
 int read_user_color_until(uint32_t deadline_ms, uint32_t *color_out)
 {
+   static SWT_Timer timeout;         // wakes pm_idle at the deadline
+   int32_t left = (int32_t)(deadline_ms - get_ms());
+   if (left > 0)
+      swt_start_ms(&timeout, (uint32_t)left, 0, wake_up, 0);
+
    while (1) {
+      PS_service(0);  // only writes if a saved score is overdue
       uint32_t now = get_ms();
       if ((int32_t)(deadline_ms - now) <= 0) {
+         swt_stop(&timeout);
          return 0;  // timeout
       }
 
+      __disable_irq();
       if (g_button_event_ready) {
-    	  __disable_irq();
          g_button_event_ready = 0;
          __enable_irq();
+         swt_stop(&timeout);
          *color_out = g_button_color_flag;  // 1..5
          return 1;                          // success
       }
+      pm_idle();      // Stop 2 while the player thinks, EXTI wakes it
+      __enable_irq();
    }
 }
 
@@ -272,9 +308,13 @@ int read_user_color_until(uint32_t deadline_ms, uint32_t *color_out)
  *     0 = no button was pressed
  */
 int level_up(void){
+   __disable_irq();
    while (!g_button_pressed_flag) {
-      software_delay(1000);
+      pm_idle();                 // EXTI wakes us on the press
+      __enable_irq();
+      __disable_irq();
    }
+   __enable_irq();
 
    g_button_pressed_flag = 0;
    return 1;
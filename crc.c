@@ -0,0 +1,60 @@
+/**
+ * @file crc.c
+ * @brief STM32L4 CRC peripheral helper
+ *
+ *  - Byte writes to DR (8-bit access) so any buffer length works
+ *  - No input/output reversal, result is the raw DR value
+ *  - Host build (EEPROM_SIM): same CRC computed bit by bit in software
+ *
+ * @date Dec. 11, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#include "crc.h"
+
+#ifndef EEPROM_SIM
+
+void CRC_init(void) {
+   RCC->AHB1ENR |= RCC_AHB1ENR_CRCEN;
+
+   CRC->CR = 0;                     // 32-bit poly, no reversal
+   CRC->POL = 0x04C11DB7;
+   CRC->INIT = 0xFFFFFFFF;
+   CRC_reset();
+}
+
+void CRC_reset(void) {
+   CRC->CR |= CRC_CR_RESET;         // DR <- INIT
+}
+
+uint32_t CRC_accumulate(const uint8_t *buf, uint16_t len) {
+   for (uint16_t i = 0; i < len; i++) {
+      *(volatile uint8_t *) &CRC->DR = buf[i];
+   }
+   return CRC->DR;
+}
+
+#else /* EEPROM_SIM */
+
+static uint32_t crc_reg;
+
+void CRC_init(void) {
+   CRC_reset();
+}
+
+void CRC_reset(void) {
+   crc_reg = 0xFFFFFFFF;
+}
+
+uint32_t CRC_accumulate(const uint8_t *buf, uint16_t len) {
+   for (uint16_t i = 0; i < len; i++) {
+      crc_reg ^= (uint32_t) buf[i] << 24;
+      for (uint8_t b = 0; b < 8; b++) {
+         crc_reg = (crc_reg & 0x80000000u) ? (crc_reg << 1) ^ 0x04C11DB7
+               : (crc_reg << 1);
+      }
+   }
+   return crc_reg;
+}
+
+#endif /* EEPROM_SIM */
@@ -0,0 +1,37 @@
+/**
+ * @file crc.h
+ * @brief Header STM32L4 CRC peripheral helper
+ *
+ *  - CRC-32 (poly 0x04C11DB7, init 0xFFFFFFFF), fed one byte at a time
+ *  - Used to seal the on-EEPROM leaderboard image
+ *
+ * @date Dec. 11, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#ifndef SRC_CRC_H_
+#define SRC_CRC_H_
+
+#ifndef EEPROM_SIM
+#include "stm32l4xx.h"
+#endif
+#include <stdint.h>
+
+/**
+ * @brief enable the CRC clock, default polynomial and init value
+ */
+void CRC_init(void);
+
+/**
+ * @brief restart the running CRC
+ */
+void CRC_reset(void);
+
+/**
+ * @brief feed len bytes into the running CRC
+ *
+ * @return CRC after the last byte
+ */
+uint32_t CRC_accumulate(const uint8_t *buf, uint16_t len);
+
+#endif /* SRC_CRC_H_ */
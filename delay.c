@@ -20,16 +20,82 @@ delay.c
 * REVISION HISTORY
 * 10/08/25	Created file
 * 11/30/25  Added ms counter
+* 12/24/25  TIM2 free-running us timebase, get_ms() no longer on SysTick
+* 12/26/25  TIM2 compare 1 drives the software timers (swtimer.c)
+* 12/29/25  timebase_advance() adds time slept in Stop 2 (lowpower.c)
 ******************************************************************************
 */
 
 #include "buttons.h"
 #include "delay.h"
+#include "swtimer.h"
 
-volatile uint32_t g_ms_ticks = 0;
+volatile uint32_t g_ms_ticks = 0;   // SysTick count, kept for HAL users
+static volatile uint32_t us_wraps = 0; // TIM2 overflows, 2^32 us each
 
 // ------------------------------------------------- delay.c w/o #includes ---
-// configure SysTick timer for use with delay_us().
+// TIM2 (32-bit) free-running at 1 MHz, never stopped or reloaded, so
+// get_us()/get_ms() keep counting through any delay. The update interrupt
+// only counts wraps (every ~71.6 min) for get_us64().
+// Call once after SystemClock_Config().
+void timebase_init(void) {
+	RCC->APB1ENR1 |= RCC_APB1ENR1_TIM2EN;
+	TIM2->CR1 = 0;
+	TIM2->PSC = (SystemCoreClock / 1000000) - 1;	// 1 tick = 1 us
+	TIM2->ARR = 0xFFFFFFFF;
+	TIM2->CNT = 0;
+	TIM2->EGR = TIM_EGR_UG;                     	// load PSC now
+	TIM2->SR = 0;                               	// UG set UIF, drop it
+	TIM2->DIER = TIM_DIER_UIE;
+	TIM2->CR1 = TIM_CR1_CEN;
+	NVIC_SetPriority(TIM2_IRQn, 0);
+	NVIC_EnableIRQ(TIM2_IRQn);
+}
+
+// update = counter wrapped, compare 1 = a software timer is due
+void TIM2_IRQHandler(void) {
+	if (TIM2->SR & TIM_SR_UIF) {
+		TIM2->SR = ~TIM_SR_UIF;
+		us_wraps++;
+	}
+	if ((TIM2->DIER & TIM_DIER_CC1IE) && (TIM2->SR & TIM_SR_CC1IF)) {
+		TIM2->SR = ~TIM_SR_CC1IF;
+		swt_expire();
+	}
+}
+
+// microseconds since timebase_init, wraps every ~71.6 min
+// (differences like now - start stay correct across the wrap)
+uint32_t get_us(void) {
+	return TIM2->CNT;
+}
+
+// microseconds since timebase_init, never wraps
+uint64_t get_us64(void) {
+	uint32_t hi, lo;
+	do {
+		hi = us_wraps;
+		lo = TIM2->CNT;
+	} while (hi != us_wraps);           	// wrap interrupt ran in between
+	// wrapped before lo was read but the interrupt is held off (masked)
+	if ((TIM2->SR & TIM_SR_UIF) && lo < 0x80000000u)
+		hi++;
+	return ((uint64_t) hi << 32) | lo;
+}
+
+// TIM2 has no clock in Stop 2: lowpower.c adds the time it measured on
+// LPTIM1 so get_us()/get_ms() read as if TIM2 had kept counting.
+// Call with interrupts masked; a jump past the wrap is counted here
+// because writing CNT does not raise the update flag.
+void timebase_advance(uint32_t us) {
+	uint32_t before = TIM2->CNT;
+	uint32_t after = before + us;
+	TIM2->CNT = after;
+	if (after < before)
+		us_wraps++;
+}
+
+// configure SysTick timer (legacy; the TIM2 timebase replaced its uses)
 // warning: breaks HAL_delay() by disabling interrupts for shorter delay timing.
 void SysTick_Init(void) {
 	SysTick->CTRL |= (SysTick_CTRL_ENABLE_Msk |     	// enable SysTick Timer
@@ -37,16 +103,13 @@ void SysTick_Init(void) {
 	SysTick->CTRL &= ~(SysTick_CTRL_TICKINT_Msk);  	// disable interrupt
 }
 
-// delay in microseconds using SysTick timer to count CPU clock cycles
-// do not call with 0 : error, maximum delay.
-// careful calling with small nums : results in longer delays than specified:
-//	   e.g. @4MHz, delay_us(1) = 10-15 us delay.
+// delay in microseconds, compares against the free-running TIM2 count
+// so it never touches the timebase and get_ms() keeps running.
+// Accurate to 1 us plus call overhead; delay_us(0) returns at once.
 void delay_us(const uint32_t time_us) {
-	// set the counts for the specified delay
-	SysTick->LOAD = (uint32_t)((time_us * (SystemCoreClock / 1000000)) - 1);
-	SysTick->VAL = 0;                                  	 // clear timer count
-	SysTick->CTRL &= ~(SysTick_CTRL_COUNTFLAG_Msk);    	 // clear count flag
-	while (!(SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk)); // wait for flag
+	uint32_t start = TIM2->CNT;
+	while ((TIM2->CNT - start) < time_us)
+		;
 }
 
 /*
@@ -87,13 +150,13 @@ void SysTick_Handler(void) {
 /*
  * Function 5:  get_ms
  * --------------------
- * counts the ticks
+ * milliseconds from the TIM2 timebase, unaffected by delays
  *
  *	takes in: nothing
  *
- *  returns: system time in ms
+ *  returns: system time in ms (wraps after ~49.7 days)
  */
 uint32_t get_ms(void) {
-   return g_ms_ticks;
+   return (uint32_t) (get_us64() / 1000u);
 }
 
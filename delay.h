@@ -20,6 +20,9 @@ delay.h
 * REVISION HISTORY
 * 10/08/25	Created file
 * 11/30/25  Added ms counter
+* 12/24/25  TIM2 free-running us timebase, get_ms() no longer on SysTick
+* 12/26/25  TIM2 compare 1 drives the software timers (swtimer.c)
+* 12/29/25  timebase_advance() prototype for Stop 2 wake-up (lowpower.c)
 ******************************************************************************
 */
 
@@ -28,16 +31,23 @@ delay.h
 #ifndef DELAY_H
 #define DELAY_H
 
+#ifndef EEPROM_SIM
 #include "stm32l4a6xx.h"
+#endif
 #include <stdint.h>      // for uint32_t an more
 
 extern volatile uint32_t g_ms_ticks;
 
 // --- Function Prototypes ---
+void timebase_init(void);
+uint32_t get_us(void);
+uint64_t get_us64(void);
+uint32_t get_ms(void);
+void timebase_advance(uint32_t us);
 void SysTick_Init(void);
 void delay_us(const uint32_t time_us);
 void software_delay(int desired_time);
 void SysTick_Handler(void);
-uint32_t get_ms(void);
+void TIM2_IRQHandler(void);
 
 #endif // DELAY_H
@@ -5,44 +5,123 @@
  *
  *  - I2C1 initialization for 400 kHz with timing: 0x00303D5B
  *  - Single-byte write: [Dev+W][AddrHi][AddrLo][Data] with AUTOEND
- *  - Single-byte read:  dummy write of 2 byte addr, repeated START, and 1 byte read
+ *  - Page write: [Dev+W][AddrHi][AddrLo][Data 1..64], split on 64-byte pages
+ *  - Write cycle end detected by ACK polling instead of a fixed delay
+ *  - Block read: dummy write of 2 byte addr, repeated START, N byte sequential
+ *    read (NBYTES reloaded every 255 bytes); single-byte read is N = 1
+ *  - Every flag wait has a DWT cycle-count deadline; a NACK or timeout ends the
+ *    transaction, a timeout also recovers the bus (9 SCL pulses + STOP),
+ *    then the transaction is retried I2C_RETRIES times
+ *  - Leaderboard image double-buffered in two banks: a save fills the idle
+ *    bank, then one generation byte commits it, so a torn save leaves the
+ *    previous bank live
+ *  - Storage tiers: internal flash EEPROM emulation as the fast primary,
+ *    the 24LC256 as a backup synced through the write-back cache
  *
  * @date Nov. 7, 2025
  * @author William Chung + Vanessa Guzman
  */
 
 #include "EEPROM.h"
+#include "eeprom_async.h"
+#include "eeprom_cache.h"
+#include "eeprom_log.h"
+#include "rank_store.h"
+#include "persist.h"
+#include "crc.h"
+#include "flash_ee.h"
 #include "delay.h"
+#include "prof.h"
+#include <stddef.h>
+#include <string.h>
+#ifdef EEPROM_SIM
+#include "eeprom_sim.h"
+#endif
 
-#define EEPROM_ADDR7 0x51        //A2:A1:A0 = 0b001 -> 0x51.
 #define I2C_TIMINGR  0x00303D5B  // 16 MHz I2C kernel
-
-/* poll I2C1->ISR flags (blocking flag waits) */
+#define I2C_STEP_TIMEOUT_MS   3  // one flag wait (a byte is 25 us at 400 kHz)
+#define I2C_WRITE_TIMEOUT_MS 10  // write cycle, 5 ms max per datasheet
+#define I2C_RETRIES           2  // extra attempts after a failed transaction
+
+#define LB_MAGIC     0x4C42      // "LB"
+#define LB_VERSION   2
+#define LB_HDR_SIZE  13              // v1 header was 12 (no generation)
+#define LB_V1_HDR    12
+#define LB_FLASH_IMAGE 0             // image offset in the flash EEPROM
+#define LB_IO_ERROR  0xFE            // count result: the 24LC256 read failed
+
+static EEPROM_Stats eeprom_stats;
+static Player *lb_board;            // board the journal checkpoints
+static uint8_t lb_flash_stale;      // flash image behind lb_board
+static uint8_t lb_count;
+static uint8_t lb_gen;              // generation of the live bank
+static uint8_t lb_offline;          // 24LC256 state unknown, never write it
+static EE_Tier lb_tier = EE_TIER_TIERED;
+
+#ifndef EEPROM_SIM
+
+/* poll I2C1->ISR flags, each wait bounded by a DWT cycle-count deadline */
 /* avoids writing RX/TX registers too early */
 
-// ready to write next byte
-static inline void wait_TXIS(void) {
-   while (!(I2C1->ISR & I2C_ISR_TXIS)) {
+// deadlines count core cycles, not get_ms(), so a wait still ends when
+// the ms timebase isn't running (before timebase_init, masked IRQs)
+static inline uint32_t ms_cycles(uint32_t ms) {
+   return ms * (SystemCoreClock / 1000u);
+}
+
+static inline uint8_t expired(uint32_t c_start, uint32_t timeout_ms) {
+   return (DWT->CYCCNT - c_start) > ms_cycles(timeout_ms);
+}
+
+// wait for flag; a NACK (when nack_aborts) or the deadline ends it early
+static EEPROM_Status wait_flag(uint32_t flag, uint8_t nack_aborts,
+      uint32_t timeout_ms) {
+   uint32_t c_start = DWT->CYCCNT;
+   while (!(I2C1->ISR & flag)) {
+      if (nack_aborts && (I2C1->ISR & I2C_ISR_NACKF)) {
+         eeprom_stats.nacks++;
+         return EEPROM_NACK;
+      }
+      if (expired(c_start, timeout_ms)) {
+         eeprom_stats.timeouts++;
+         return EEPROM_TIMEOUT;
+      }
    }
+   return EEPROM_OK;
+}
+
+// ready to write next byte
+static inline EEPROM_Status wait_TXIS(void) {
+   return wait_flag(I2C_ISR_TXIS, 1, I2C_STEP_TIMEOUT_MS);
 }
 
 // found a byte arrived to read
-static inline void wait_RXNE(void) {
-   while (!(I2C1->ISR & I2C_ISR_RXNE)) {
-   }
+static inline EEPROM_Status wait_RXNE(void) {
+   return wait_flag(I2C_ISR_RXNE, 0, I2C_STEP_TIMEOUT_MS);
 }
 
 // transfer of NBYTES done (no STOP)
-static inline void wait_TC(void) {
-   while (!(I2C1->ISR & I2C_ISR_TC)) {
-   }
+static inline EEPROM_Status wait_TC(void) {
+   return wait_flag(I2C_ISR_TC, 1, I2C_STEP_TIMEOUT_MS);
 }
 
 // STOP (clear reg)
-static inline void wait_STOP(void) {
-   while (!(I2C1->ISR & I2C_ISR_STOPF)) {
-   }
+static inline EEPROM_Status wait_STOP(void) {
+   EEPROM_Status st = wait_flag(I2C_ISR_STOPF, 0, I2C_STEP_TIMEOUT_MS);
    I2C1->ICR = I2C_ICR_STOPCF;
+   return st;
+}
+
+// bus idle before a new START
+static EEPROM_Status wait_idle(void) {
+   uint32_t c_start = DWT->CYCCNT;
+   while (I2C1->ISR & I2C_ISR_BUSY) {
+      if (expired(c_start, I2C_STEP_TIMEOUT_MS)) {
+         eeprom_stats.timeouts++;
+         return EEPROM_TIMEOUT;
+      }
+   }
+   return EEPROM_OK;
 }
 
 // GPIO PB8/PB9 AF4 open-drain pull-up
@@ -66,6 +145,10 @@ void I2C1_GPIO_Init(void) {
 void EEPROM_init(void) {
    I2C1_GPIO_Init();
 
+   // cycle counter for the flag-wait deadlines (prof_init may reset it)
+   CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+   DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
    // Turn on HSI16 and select as I2C1 kernel clock
    RCC->CR |= RCC_CR_HSION;
    while ((RCC->CR & RCC_CR_HSIRDY) == 0) {
@@ -94,119 +177,745 @@ void EEPROM_init(void) {
 
    // enable I2C peripheral
    I2C1->CR1 |= I2C_CR1_PE;
+
+   EEPROM_async_init();             // DMA + EV/ER interrupts for async xfers
+   CRC_init();                      // seals the leaderboard image
+   FEE_mount();                     // internal flash tier
+}
+
+// half an SCL period at 100 kHz for bus recovery
+static void bit_delay(void) {
+   delay_us(5);
+}
+
+// bus recovery: a slave cut off mid-byte can hold SDA low forever.
+// PE off, drive SCL by hand for 9 clocks so it shifts the byte out and
+// releases SDA, send a STOP, then hand the pins back to I2C1.
+static void I2C1_bus_recover(void) {
+   I2C1->CR1 &= ~I2C_CR1_PE;        // resets the I2C1 state machine
+
+   GPIOB->BSRR = (1u << 8) | (1u << 9);        // open drain: released
+   GPIOB->MODER &= ~((3u << (8 * 2)) | (3u << (9 * 2)));
+   GPIOB->MODER |= ((1u << (8 * 2)) | (1u << (9 * 2)));      // GP output
+
+   for (uint8_t i = 0; i < 9; i++) {          // 9 SCL pulses
+      GPIOB->BRR = 1u << 8;
+      bit_delay();
+      GPIOB->BSRR = 1u << 8;
+      bit_delay();
+   }
+   // STOP: SDA rises while SCL is high
+   GPIOB->BRR = 1u << 8;
+   bit_delay();
+   GPIOB->BRR = 1u << 9;
+   bit_delay();
+   GPIOB->BSRR = 1u << 8;
+   bit_delay();
+   GPIOB->BSRR = 1u << 9;
+   bit_delay();
+
+   GPIOB->MODER &= ~((3u << (8 * 2)) | (3u << (9 * 2)));
+   GPIOB->MODER |= ((2u << (8 * 2)) | (2u << (9 * 2)));      // AF mode
+
+   I2C1->ICR = I2C_ICR_STOPCF | I2C_ICR_NACKCF | I2C_ICR_BERRCF | I2C_ICR_ARLOCF
+         | I2C_ICR_OVRCF;
+   I2C1->CR1 |= I2C_CR1_PE;
+   eeprom_stats.bus_recoveries++;
 }
 
-void EEPROM_write(uint16_t addr, uint8_t data) {
-   while (I2C1->ISR & I2C_ISR_BUSY) {     // wait until I2C bus is idle
+void EEPROM_bus_timeout(void) {
+   eeprom_stats.timeouts++;
+   I2C1_bus_recover();
+}
+
+// failed transaction: a NACK already ended with an automatic STOP, just
+// let it finish; anything else leaves the bus in an unknown state
+static void end_failed(EEPROM_Status st) {
+   if (st == EEPROM_NACK && wait_STOP() == EEPROM_OK) {
+      I2C1->ICR = I2C_ICR_NACKCF;
+      return;
+   }
+   I2C1_bus_recover();
+}
+
+// ACK polling: address the part with a 0-byte write until it ACKs.
+// 24LC256 NACKs its control byte while the internal write cycle runs.
+static EEPROM_Status EEPROM_ack_poll(void) {
+   uint32_t c_start = DWT->CYCCNT;
+   while (1) {
+      I2C1->ICR = I2C_ICR_STOPCF | I2C_ICR_NACKCF;
+      I2C1->CR2 = ((EEPROM_ADDR7 << 1) & I2C_CR2_SADD) | I2C_CR2_AUTOEND;
+      I2C1->CR2 |= I2C_CR2_START;     // [Dev+W] then STOP
+      EEPROM_Status st = wait_STOP();
+      if (st != EEPROM_OK) {
+         return st;
+      }
+      eeprom_stats.ack_polls++;
+      if (!(I2C1->ISR & I2C_ISR_NACKF)) {
+         break;                       // ACK -> write cycle finished
+      }
+      if (expired(c_start, I2C_WRITE_TIMEOUT_MS)) {
+         I2C1->ICR = I2C_ICR_NACKCF;
+         eeprom_stats.timeouts++;
+         return EEPROM_TIMEOUT;       // part gone or stuck in its cycle
+      }
+   }
+   I2C1->ICR = I2C_ICR_NACKCF;
+   return EEPROM_OK;
+}
+
+// one page-bounded write transaction plus its write cycle
+static EEPROM_Status write_chunk(uint16_t addr, const uint8_t *buf,
+      uint16_t chunk) {
+   EEPROM_Status st = wait_idle();  // wait until I2C bus is idle
+   if (st != EEPROM_OK) {
+      return st;
    }
    I2C1->ICR = I2C_ICR_STOPCF | I2C_ICR_NACKCF; // clear STOP and NACK flags
 
-   // configure 3-byte write (AddrHi, AddrLo, Data) with auto STOP
-   I2C1->CR2 = ((EEPROM_ADDR7 << 1) & I2C_CR2_SADD) | (3u << I2C_CR2_NBYTES_Pos)
-         | I2C_CR2_AUTOEND;
-   I2C1->CR2 &= ~I2C_CR2_RD_WRN;            // write
+   // configure (2 + chunk)-byte write with auto STOP
+   I2C1->CR2 = ((EEPROM_ADDR7 << 1) & I2C_CR2_SADD)
+         | ((uint32_t) (chunk + 2) << I2C_CR2_NBYTES_Pos) | I2C_CR2_AUTOEND;
    I2C1->CR2 |= I2C_CR2_START;              // generate start condition
 
-   wait_TXIS();
-   I2C1->TXDR = (uint8_t) (addr >> 8); // send address high byte
-   wait_TXIS();
+   if ((st = wait_TXIS()) != EEPROM_OK) {
+      return st;
+   }
+   I2C1->TXDR = (uint8_t) (addr >> 8);   // send address high byte
+   if ((st = wait_TXIS()) != EEPROM_OK) {
+      return st;
+   }
    I2C1->TXDR = (uint8_t) (addr & 0xFF); // send address low byte
-   wait_TXIS();
-   I2C1->TXDR = data; // send data byte
+   for (uint16_t i = 0; i < chunk; i++) {
+      if ((st = wait_TXIS()) != EEPROM_OK) {
+         return st;
+      }
+      I2C1->TXDR = buf[i];
+   }
+   if ((st = wait_STOP()) != EEPROM_OK) {  // STOP starts the write cycle
+      return st;
+   }
+
+   eeprom_stats.write_transactions++;
+   eeprom_stats.bytes_written += chunk;
 
-   wait_STOP();                    // wait for STOP indicating transfer complete
+   return EEPROM_ack_poll();        // block until the write cycle is done
 }
 
-uint8_t EEPROM_read(uint16_t addr) {
-   while (I2C1->ISR & I2C_ISR_BUSY) {           // wait until I2C bus is idle
+// address phase, repeated START, then the whole sequential read
+static EEPROM_Status read_once(uint16_t addr, uint8_t *buf, uint16_t len) {
+   EEPROM_Status st = wait_idle();  // wait until I2C bus is idle
+   if (st != EEPROM_OK) {
+      return st;
    }
    I2C1->ICR = I2C_ICR_STOPCF | I2C_ICR_NACKCF; // clear STOP and NACK flags
 
    // 1st part: write 2 byte address (no AUTOEND, no STOP)
-   I2C1->CR2 = ((0x51 << 1) & I2C_CR2_SADD) | (2u << I2C_CR2_NBYTES_Pos); // 2 bytes to send
-   I2C1->CR2 &= ~I2C_CR2_RD_WRN; // write mode
+   I2C1->CR2 = ((EEPROM_ADDR7 << 1) & I2C_CR2_SADD) | (2u << I2C_CR2_NBYTES_Pos);
    I2C1->CR2 |= I2C_CR2_START; // generate START condition
 
-   while (!(I2C1->ISR & I2C_ISR_TXIS)) {  // wait TX ready
-   };
-   I2C1->TXDR = addr >> 8; // send address high byte
+   if ((st = wait_TXIS()) != EEPROM_OK) {
+      return st;
+   }
+   I2C1->TXDR = (uint8_t) (addr >> 8);   // send address high byte
+   if ((st = wait_TXIS()) != EEPROM_OK) {
+      return st;
+   }
+   I2C1->TXDR = (uint8_t) (addr & 0xFF); // send address low byte
+   if ((st = wait_TC()) != EEPROM_OK) {  // repeated START next
+      return st;
+   }
 
-   while (!(I2C1->ISR & I2C_ISR_TXIS)) {
-   };
+   // 2nd part: sequential read, NBYTES is 8 bits so reload every 255 bytes
+   // last chunk uses AUTOEND (resulting in NACK+STOP)
+   uint16_t chunk = (len > 255u) ? 255u : len;
+   I2C1->CR2 = ((EEPROM_ADDR7 << 1) & I2C_CR2_SADD)
+         | ((uint32_t) chunk << I2C_CR2_NBYTES_Pos) | I2C_CR2_RD_WRN
+         | ((len > 255u) ? I2C_CR2_RELOAD : I2C_CR2_AUTOEND);
+   I2C1->CR2 |= I2C_CR2_START;               // repeat start
 
-   I2C1->TXDR = addr & 0xFF;  // send address low byte
-   while (!(I2C1->ISR & I2C_ISR_TC)) {
-   }                          // repeated START next
+   while (1) {
+      for (uint16_t i = 0; i < chunk; i++) {
+         if ((st = wait_RXNE()) != EEPROM_OK) {
+            return st;
+         }
+         *buf++ = (uint8_t) I2C1->RXDR;
+      }
+      len -= chunk;
+      if (len == 0) {
+         break;
+      }
+      // NBYTES ran out with RELOAD set: load the next chunk, no new START
+      if ((st = wait_flag(I2C_ISR_TCR, 0, I2C_STEP_TIMEOUT_MS)) != EEPROM_OK) {
+         return st;
+      }
+      chunk = (len > 255u) ? 255u : len;
+      uint32_t cr2 = I2C1->CR2 & ~(I2C_CR2_NBYTES | I2C_CR2_RELOAD);
+      cr2 |= ((uint32_t) chunk << I2C_CR2_NBYTES_Pos)
+            | ((len > 255u) ? I2C_CR2_RELOAD : I2C_CR2_AUTOEND);
+      I2C1->CR2 = cr2;
+   }
+   st = wait_STOP();
+   I2C1->ICR = I2C_ICR_NACKCF;
 
-   // 2nd part: read 1 byte with AUTOEND (resulting in NACK+STOP)
-   I2C1->CR2 = ((0x51 << 1) & I2C_CR2_SADD) | (1u << I2C_CR2_NBYTES_Pos)
-         | I2C_CR2_RD_WRN | I2C_CR2_AUTOEND; // 1 byte read
-   I2C1->CR2 |= I2C_CR2_START;               // repeat start
+   eeprom_stats.read_transactions++;
+   return st;
+}
+
+#else /* EEPROM_SIM */
+
+/* host build: transactions go to the 24LC256 model in eeprom_sim.c, the
+ * retry/ACK-poll logic and the counters above it are the same as on target */
+
+static EEPROM_Status count_error(EEPROM_Status st) {
+   if (st == EEPROM_NACK) {
+      eeprom_stats.nacks++;
+   } else if (st == EEPROM_TIMEOUT) {
+      eeprom_stats.timeouts++;
+   }
+   return st;
+}
+
+void I2C1_GPIO_Init(void) {
+}
+
+void EEPROM_init(void) {
+   CRC_init();                      // software CRC-32 on the host
+   FEE_mount();
+}
+
+static void end_failed(EEPROM_Status st) {
+   if (st == EEPROM_TIMEOUT) {
+      EE_sim_bus_recover();
+      eeprom_stats.bus_recoveries++;
+   }
+}
+
+static EEPROM_Status EEPROM_ack_poll(void) {
+   uint32_t t_start = get_ms();
+   while (1) {
+      EEPROM_Status st = EE_sim_i2c_write(NULL, 0);
+      if (st == EEPROM_TIMEOUT) {
+         return count_error(st);
+      }
+      eeprom_stats.ack_polls++;
+      if (st == EEPROM_OK) {
+         return EEPROM_OK;            // ACK -> write cycle finished
+      }
+      if (get_ms() - t_start > I2C_WRITE_TIMEOUT_MS) {
+         return count_error(EEPROM_TIMEOUT);
+      }
+   }
+}
+
+static EEPROM_Status write_chunk(uint16_t addr, const uint8_t *buf,
+      uint16_t chunk) {
+   uint8_t frame[2 + EEPROM_PAGE_SIZE];
+
+   frame[0] = (uint8_t) (addr >> 8);
+   frame[1] = (uint8_t) (addr & 0xFF);
+   memcpy(&frame[2], buf, chunk);
+   EEPROM_Status st = count_error(EE_sim_i2c_write(frame, chunk + 2));
+   if (st != EEPROM_OK) {
+      return st;
+   }
+
+   eeprom_stats.write_transactions++;
+   eeprom_stats.bytes_written += chunk;
+
+   return EEPROM_ack_poll();
+}
+
+static EEPROM_Status read_once(uint16_t addr, uint8_t *buf, uint16_t len) {
+   uint8_t frame[2] = { (uint8_t) (addr >> 8), (uint8_t) (addr & 0xFF) };
+
+   EEPROM_Status st = count_error(EE_sim_i2c_write(frame, sizeof(frame)));
+   if (st == EEPROM_OK) {
+      st = count_error(EE_sim_i2c_read(buf, len));
+   }
+   if (st == EEPROM_OK) {
+      eeprom_stats.read_transactions++;
+   }
+   return st;
+}
+
+#endif /* EEPROM_SIM */
+
+EEPROM_Status EEPROM_write_page(uint16_t addr, const uint8_t *buf,
+      uint16_t len) {
+   EEPROM_Status st = EEPROM_OK;
+
+   EEPROM_async_lock();             // queued async work finishes first
+   while (len > 0) {
+      // never cross a 64-byte page, the part would wrap inside the page
+      uint16_t room = EEPROM_PAGE_SIZE - (addr % EEPROM_PAGE_SIZE);
+      uint16_t chunk = (len < room) ? len : room;
+
+      for (uint8_t attempt = 0; ; attempt++) {
+         st = write_chunk(addr, buf, chunk);
+         if (st == EEPROM_OK) {
+            break;
+         }
+         end_failed(st);
+         if (attempt == I2C_RETRIES) {
+            eeprom_stats.failures++;
+            EEPROM_async_unlock();
+            return st;
+         }
+         eeprom_stats.retries++;
+      }
+
+      addr += chunk;
+      buf += chunk;
+      len -= chunk;
+   }
+   EEPROM_async_unlock();
+   return st;
+}
 
-   while (!(I2C1->ISR & I2C_ISR_RXNE)) {    // wait until data received
+EEPROM_Status EEPROM_write(uint16_t addr, uint8_t data) {
+   PROF_BEGIN(PROF_EEPROM_WRITE);
+   EEPROM_Status st = EEPROM_write_page(addr, &data, 1);
+   PROF_END(PROF_EEPROM_WRITE);
+   return st;
+}
+
+EEPROM_Status EEPROM_read_block(uint16_t addr, uint8_t *buf, uint16_t len) {
+   EEPROM_Status st = EEPROM_OK;
+
+   if (len == 0) {
+      return st;
    }
-   uint8_t b = I2C1->RXDR;                  // read data byte
-   while (!(I2C1->ISR & I2C_ISR_STOPF)) {   // wait stop condition
+   EEPROM_async_lock();
+   for (uint8_t attempt = 0; ; attempt++) {
+      st = read_once(addr, buf, len);
+      if (st == EEPROM_OK) {
+         break;
+      }
+      end_failed(st);
+      if (attempt == I2C_RETRIES) {
+         eeprom_stats.failures++;
+         break;
+      }
+      eeprom_stats.retries++;
    }
-   I2C1->ICR = I2C_ICR_STOPCF | I2C_ICR_NACKCF; // clear flags
+   EEPROM_async_unlock();
+   return st;
+}
+
+uint8_t EEPROM_read(uint16_t addr) {
+   uint8_t b = 0xFF;                            // erased value on failure
+   PROF_BEGIN(PROF_EEPROM_READ);
+   EEPROM_read_block(addr, &b, 1);
+   PROF_END(PROF_EEPROM_READ);
    return b;                                    // return read byte
 }
 
-//loops thru characters in name, saves to 3 consecutive addresses
-//last 2 addresses are for score (high byte and low byte)
-void saveLeaderboard(Player *board, uint8_t count) {
-    uint16_t addr = 0;
-    for (uint8_t i = 0; i < count; i++) {
-        for (uint8_t j = 0; j < NAME_LEN; j++)
-            EEPROM_write(addr++, board[i].name[j]);
-        EEPROM_write(addr++, (board[i].score >> 8) & 0xFF);
-        EEPROM_write(addr++, board[i].score & 0xFF);
+void packPlayer(const Player *p, uint8_t *rec) {
+    for (uint8_t j = 0; j < NAME_LEN; j++)
+        rec[j] = p->name[j];
+    rec[NAME_LEN] = (p->score >> 8) & 0xFF;
+    rec[NAME_LEN + 1] = p->score & 0xFF;
+}
+
+void unpackPlayer(const uint8_t *rec, Player *p) {
+    for (uint8_t j = 0; j < NAME_LEN; j++)
+        p->name[j] = rec[j];
+    p->score = ((uint16_t)rec[NAME_LEN] << 8) | rec[NAME_LEN + 1];
+}
+
+static uint32_t imageCrc(const uint8_t *hdr, uint8_t hdr_len,
+        const uint8_t *entries, uint8_t count) {
+    CRC_reset();
+    CRC_accumulate(hdr, 8);             //magic..seq_base, crc field excluded
+    CRC_accumulate(&hdr[12], hdr_len - 12); //generation (v2)
+    return CRC_accumulate(entries, count * PLAYER_REC_SIZE);
+}
+
+static inline uint16_t bankAddr(uint8_t gen) {
+    return (gen & 1) ? LB_BANK_B_ADDR : LB_BANK_A_ADDR;
+}
+
+//builds the v2 image: header + only the populated entries, 63 bytes at
+//most; returns its length
+static uint8_t buildImage(uint8_t *buf, const Player *board, uint8_t count,
+        uint32_t seq_base, uint8_t gen) {
+    buf[0] = LB_MAGIC >> 8;
+    buf[1] = LB_MAGIC & 0xFF;
+    buf[2] = LB_VERSION;
+    buf[3] = count;
+    buf[4] = (uint8_t)seq_base;
+    buf[5] = (uint8_t)(seq_base >> 8);
+    buf[6] = (uint8_t)(seq_base >> 16);
+    buf[7] = (uint8_t)(seq_base >> 24);
+    buf[12] = gen;
+    for (uint8_t i = 0; i < count; i++)
+        packPlayer(&board[i], &buf[LB_HDR_SIZE + i * PLAYER_REC_SIZE]);
+    uint32_t crc = imageCrc(buf, LB_HDR_SIZE, &buf[LB_HDR_SIZE], count);
+    buf[8] = (uint8_t)crc;
+    buf[9] = (uint8_t)(crc >> 8);
+    buf[10] = (uint8_t)(crc >> 16);
+    buf[11] = (uint8_t)(crc >> 24);
+    return LB_HDR_SIZE + count * PLAYER_REC_SIZE;
+}
+
+//writes the image into the bank gen selects, one page write
+static EEPROM_Status writeImage(const Player *board, uint8_t count,
+        uint32_t seq_base, uint8_t gen) {
+    uint8_t buf[LB_HDR_SIZE + MAX_PLAYERS * PLAYER_REC_SIZE];
+    return EE_cache_write(bankAddr(gen), buf,
+            buildImage(buf, board, count, seq_base, gen));
+}
+
+//internal flash copy: seq_base/gen are fixed so a save only reprograms
+//the words of entries that actually changed (plus count and CRC)
+static void writeFlashImage(const Player *board, uint8_t count) {
+    uint8_t buf[LB_HDR_SIZE + MAX_PLAYERS * PLAYER_REC_SIZE];
+    FEE_write(LB_FLASH_IMAGE, buf, buildImage(buf, board, count, 0, 0));
+    lb_flash_stale = 0;
+}
+
+uint8_t flashImageStale(void) {
+    return lb_flash_stale;
+}
+
+//the flash write addScore deferred, done from PS_service at idle time
+uint8_t syncFlashImage(void) {
+    if (!lb_flash_stale)
+        return 0;
+    writeFlashImage(lb_board, lb_count);
+    return 1;
+}
+
+//where an image is read from: EE_cache_read (24LC256) or flashRead
+typedef EEPROM_Status (*ImageReader)(uint16_t addr, uint8_t *buf,
+        uint16_t len);
+
+static EEPROM_Status flashRead(uint16_t addr, uint8_t *buf, uint16_t len) {
+    FEE_read(addr, buf, len);           //RAM-indexed, cannot fail
+    return EEPROM_OK;
+}
+
+//reads the header of one image, then just count entries; one CRC check
+//for all of it. board may be NULL to only validate the image.
+//returns entry count, LB_NO_IMAGE if missing/corrupt/unknown version,
+//or LB_IO_ERROR if the read itself failed (contents unknown)
+static uint8_t readImage(ImageReader rd, uint16_t addr, Player *board,
+        uint32_t *seq_base, uint8_t *gen) {
+    uint8_t hdr[LB_HDR_SIZE];
+    uint8_t entries[MAX_PLAYERS * PLAYER_REC_SIZE];
+    uint8_t hdr_len;
+
+    if (rd(addr, hdr, LB_HDR_SIZE) != EEPROM_OK)
+        return LB_IO_ERROR;
+    uint8_t count = hdr[3];
+    if (((hdr[0] << 8) | hdr[1]) != LB_MAGIC || count > MAX_PLAYERS)
+        return LB_NO_IMAGE;
+
+    switch (hdr[2]) {
+    case 1:                             //single image, bank A only
+        if (addr != LB_BANK_A_ADDR)
+            return LB_NO_IMAGE;
+        hdr_len = LB_V1_HDR;
+        break;
+    case LB_VERSION:
+        hdr_len = LB_HDR_SIZE;
+        break;
+    default:                            //newer firmware wrote it
+        return LB_NO_IMAGE;
+    }
+
+    if (rd(addr + hdr_len, entries, count * PLAYER_REC_SIZE) != EEPROM_OK)
+        return LB_IO_ERROR;
+    uint32_t crc = hdr[8] | ((uint32_t)hdr[9] << 8) | ((uint32_t)hdr[10] << 16)
+            | ((uint32_t)hdr[11] << 24);
+    if (crc != imageCrc(hdr, hdr_len, entries, count))
+        return LB_NO_IMAGE;
+
+    if (board) {
+        for (uint8_t i = 0; i < count; i++)
+            unpackPlayer(&entries[i * PLAYER_REC_SIZE], &board[i]);
     }
+    *seq_base = hdr[4] | ((uint32_t)hdr[5] << 8) | ((uint32_t)hdr[6] << 16)
+            | ((uint32_t)hdr[7] << 24);
+    *gen = (hdr_len == LB_HDR_SIZE) ? hdr[12] : 0;
+    return count;
 }
 
-//uses *board to point to each player in array
-//reads initials, then score
-uint8_t loadLeaderboard(Player *board) {
-    uint16_t addr = 0;
+//boot bank choice: the committed bank when it checks out, else whichever
+//bank holds the newest valid image (torn commit byte or torn bank write).
+//Any failed read gives LB_IO_ERROR: the choice cannot be made safely.
+static uint8_t readNewestImage(Player *board, uint32_t *seq_base) {
+    uint8_t commit;
+    uint8_t gen = 0, other_gen;
+    uint32_t other_base;
+
+    if (EE_cache_read(LB_COMMIT_ADDR, &commit, 1) != EEPROM_OK)
+        return LB_IO_ERROR;
+    uint8_t count = readImage(EE_cache_read, bankAddr(commit), board, seq_base,
+            &gen);
+    if (count == LB_IO_ERROR)
+        return LB_IO_ERROR;
+    if (count != LB_NO_IMAGE && gen == commit) {
+        lb_gen = gen;
+        return count;
+    }
+
+    uint8_t other = readImage(EE_cache_read, bankAddr(commit + 1), NULL,
+            &other_base, &other_gen);
+    if (other == LB_IO_ERROR)
+        return LB_IO_ERROR;
+    if (other != LB_NO_IMAGE
+            && (count == LB_NO_IMAGE || (int8_t)(other_gen - gen) > 0)) {
+        count = readImage(EE_cache_read, bankAddr(commit + 1), board,
+                seq_base, &gen);
+    }
+    lb_gen = gen;
+    return count;
+}
+
+//24LC256 save: new image tagged with the journal's next seq goes to the
+//idle bank, then the generation byte flips to it, then the journal starts
+//over (everything before is now in the image). The cache flushes pages in
+//address order, so the bank lands before the commit byte; the barrier
+//holds back the journal pages until both are on the part, or a record of
+//the new pass could overwrite slot 0 while the old image still needs it
+//(commit write failed, or its page was on the bus with the old byte).
+//Skipped while the part is offline (boot could not read it), and the
+//commit byte only moves once the bank is staged. The journal restarts
+//only when both made it into the cache.
+static EEPROM_Status saveExternal(const Player *board, uint8_t count) {
+    uint8_t gen = lb_gen + 1;
+    EEPROM_Status st;
+
+    if (lb_offline)
+        return EEPROM_NACK;
+    st = writeImage(board, count, EE_log_next_seq(), gen);
+    if (st == EEPROM_OK)
+        st = EE_cache_write(LB_COMMIT_ADDR, &gen, 1);
+    if (st != EEPROM_OK) {
+        eeprom_stats.failures++;
+        return st;
+    }
+    EE_cache_barrier(LB_BANK_A_ADDR, LB_COMMIT_ADDR + 1 - LB_BANK_A_ADDR);
+    lb_gen = gen;
+    EE_log_restart();
+    return EEPROM_OK;
+}
+
+void EEPROM_set_tier(EE_Tier tier) {
+    lb_tier = tier;
+}
+
+//full save on the selected tier(s); the 24LC256 part only reaches the
+//cache here, its pages go out on the next flush
+void saveLeaderboard(Player *board, uint8_t count) {
+    uint32_t t_start = get_ms();
+
+    lb_board = board;
+    lb_count = count;
+    if (lb_tier != EE_TIER_INTERNAL)
+        saveExternal(board, count);
+    if (lb_tier != EE_TIER_EXTERNAL)
+        writeFlashImage(board, count);
+    eeprom_stats.last_save_ms = get_ms() - t_start;
+}
+
+//journal region full: fold it into a fresh image (journal is 24LC256 only)
+static EEPROM_Status checkpointLeaderboard(void) {
+    return saveExternal(lb_board, lb_count);
+}
+
+//same as saveLeaderboard, then hands the dirty image page to the I2C1 engine
+//returns right away; the game keeps running while the pages are written
+uint8_t saveLeaderboard_async(Player *board, uint8_t count) {
+    saveLeaderboard(board, count);
+    return EE_cache_flush_async();
+}
+
+const EEPROM_Stats *EEPROM_get_stats(void) {
+    return &eeprom_stats;
+}
+
+void EEPROM_reset_stats(void) {
+    eeprom_stats = (EEPROM_Stats){0};
+}
+
+//v0 layout: 10 x 5 bytes packed at EEPROM_START_ADDR, validity guessed
+//from the score; migrated to a banked image the first time we boot on it
+static uint8_t loadLegacyLeaderboard(Player *board) {
+    uint8_t buf[MAX_PLAYERS * PLAYER_REC_SIZE];
     uint8_t count = 0;
+
+    if (EE_cache_read(EEPROM_START_ADDR, buf, sizeof(buf)) != EEPROM_OK)
+        return LB_IO_ERROR;
     for (uint8_t i = 0; i < MAX_PLAYERS; i++) {
-        for (uint8_t j = 0; j < NAME_LEN; j++)
-            board[i].name[j] = EEPROM_read(addr++);
-        	delay_us(5);
-        board[i].score = ((uint16_t)EEPROM_read(addr++) << 8);
-        board[i].score |= EEPROM_read(addr++);
-        if (board[i].score > 0 && board[i].score < 9999) //ensure score is valid
+        unpackPlayer(&buf[i * PLAYER_REC_SIZE], &board[count]);
+        if (board[count].score > 0 && board[count].score < 9999) //ensure score is valid
             count++;
     }
     return count;
 }
 
+//copies journaled slots over the board, returns the new count
+static uint8_t replayJournal(Player *board, uint8_t count) {
+    uint8_t rec[EE_LOG_PAYLOAD];
+    for (uint8_t i = 0; i < MAX_PLAYERS; i++) {
+        if (EE_log_get(i, rec) != PLAYER_REC_SIZE)
+            continue;
+        unpackPlayer(rec, &board[i]);
+        if (i >= count)
+            count = i + 1;
+    }
+    return count;
+}
+
+//newest bank + journal tail; falls back to older layouts and migrates them.
+//Migration only runs after reads that succeeded and found no image; a
+//failed read returns LB_IO_ERROR with the 24LC256 left untouched and
+//marked offline, so a bus fault at boot cannot overwrite a bank.
+static uint8_t loadExternal(Player *board) {
+    uint32_t seq_base;
+    uint8_t count = readNewestImage(board, &seq_base);
+    uint8_t keys;
+
+    lb_offline = 0;
+    if (count == LB_IO_ERROR) {
+        //nothing known about the part
+    } else if (count != LB_NO_IMAGE) {
+        if (EE_log_mount(seq_base) == EE_LOG_IO_ERROR)
+            count = LB_IO_ERROR;
+        else
+            count = replayJournal(board, count);
+    } else if ((keys = EE_log_scan_all()) == EE_LOG_IO_ERROR) {
+        count = LB_IO_ERROR;
+    } else if (keys > 0) {
+        count = replayJournal(board, 0);    //journal-only layout
+        saveExternal(board, count);
+    } else {
+        count = loadLegacyLeaderboard(board);
+        if (count != LB_IO_ERROR) {
+            sortLeaderboard(board, count);
+            saveExternal(board, count);
+        }
+    }
+    if (count == LB_IO_ERROR) {
+        lb_offline = 1;
+        eeprom_stats.load_errors++;
+    }
+    return count;
+}
+
+static uint8_t sameBoard(const Player *a, const Player *b, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (a[i].score != b[i].score
+                || memcmp(a[i].name, b[i].name, NAME_LEN) != 0)
+            return 0;
+    }
+    return 1;
+}
+
+//internal flash image is the primary copy when that tier is on; tiered
+//mode still mounts the 24LC256 journal and resyncs the backup if the last
+//async sync never landed. A tier with no image yet is seeded from the
+//24LC256 copy.
+uint8_t loadLeaderboard(Player *board) {
+    static Player backup[MAX_PLAYERS];
+    uint32_t seq_base;
+    uint8_t gen;
+    uint8_t count = LB_NO_IMAGE;
+
+    lb_board = board;
+    lb_flash_stale = 0;
+    EE_log_set_checkpoint(checkpointLeaderboard);
+
+    if (lb_tier != EE_TIER_EXTERNAL)
+        count = readImage(flashRead, LB_FLASH_IMAGE, board, &seq_base, &gen);
+
+    if (count == LB_NO_IMAGE) {
+        count = loadExternal(board);
+        if (count == LB_IO_ERROR)
+            count = 0;              //play on from an empty board in RAM
+        else if (lb_tier != EE_TIER_EXTERNAL)
+            writeFlashImage(board, count);
+    } else if (lb_tier == EE_TIER_TIERED) {
+        uint8_t backup_count = loadExternal(backup);
+        if (backup_count != LB_IO_ERROR && (backup_count != count
+                || !sameBoard(board, backup, count)))
+            saveExternal(board, count);
+    }
+    lb_count = count;
+    return count;
+}
+
+//stable insertion sort, highest score first; equal scores keep their
+//order so whoever got there first stays ahead
 void sortLeaderboard(Player *board, uint8_t count) {
-	for(uint8_t i = 0; i < count-1; i++) {
-		for (uint8_t j = 1; j < count; j++){
-			if (board[i].score < board[j].score){
-				Player temp = board[i]; //create temp variable so we don't lose entry
-				board[j] = board[i];  //swap
-				temp = board[j];
+    for (uint8_t i = 1; i < count; i++) {
+        Player temp = board[i]; //hold entry while larger ones shift down
+        uint8_t j = i;
+        while (j > 0 && board[j - 1].score < temp.score) {
+            board[j] = board[j - 1];
+            j--;
+        }
+        board[j] = temp;
+    }
+}
 
-			}
-		}
+//binary search on a sorted board: first slot whose score is lower than
+//score, so a tie lands below the existing entries
+uint8_t leaderboardRank(const Player *board, uint8_t count, uint16_t score) {
+    uint8_t lo = 0;
+    uint8_t hi = count;
+    while (lo < hi) {
+        uint8_t mid = (lo + hi) / 2;
+        if (board[mid].score >= score)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
 
-	}
+//journals slots first..last only, as one batch: a torn journal page must
+//not replay half of a shift
+static void saveSlots(const Player *board, uint8_t first, uint8_t last) {
+    uint8_t rec[PLAYER_REC_SIZE];
+    if (lb_offline)
+        return;
+    EE_log_batch_begin();
+    for (uint8_t i = first; i <= last; i++) {
+        packPlayer(&board[i], rec);
+        EE_log_put(i, rec, PLAYER_REC_SIZE);
+    }
+    EE_log_batch_end();
 }
 
+//board stays sorted: find the slot by binary search, shift the entries
+//below it down one (lowest falls off when full), persist only the slots
+//that changed. On the 24LC256 that is RAM only (journal slots in the
+//cache); the rank store insert, page writes and the internal flash image
+//wait for PS_service() at idle time.
 uint8_t addScore(Player *board, uint8_t count, const char *name, uint16_t score) {
-    if (count < MAX_PLAYERS) {
-        for (uint8_t i = 0; i < NAME_LEN; i++)  //when !10 entries
-            board[count].name[i] = name[i];
-        board[count].score = score;
-        count++; //increase count until reaching 10 players
-    } else if (score > board[count - 1].score) { //if newest score > lowest score
-        for (uint8_t i = 0; i < NAME_LEN; i++)
-            board[count - 1].name[i] = name[i]; //replace lowest score with new score
-        board[count - 1].score = score;
-    }
-    sortLeaderboard(board, count);
-    saveLeaderboard(board, count);
+    PS_queue_score(name, score);
+
+    uint8_t pos = leaderboardRank(board, count, score);
+    if (pos >= MAX_PLAYERS)
+        return count;   //not a top score
+
+    if (count < MAX_PLAYERS)
+        count++;
+    for (uint8_t i = count - 1; i > pos; i--)
+        board[i] = board[i - 1];
+    for (uint8_t i = 0; i < NAME_LEN; i++)
+        board[pos].name[i] = name[i];
+    board[pos].score = score;
+
+    lb_board = board;
+    lb_count = count;
+    if (lb_tier != EE_TIER_INTERNAL)
+        saveSlots(board, pos, count - 1);
+    if (lb_tier != EE_TIER_EXTERNAL)
+        lb_flash_stale = 1;
     return count;
 }
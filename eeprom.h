@@ -5,7 +5,10 @@
  *
  *  - I2C1 initialization for 400 kHz with timing: 0x00303D5B
  *  - Single-byte write: [Dev+W][AddrHi][AddrLo][Data] with AUTOEND
+ *  - Page write: up to 64 bytes per transaction, ACK polled for write cycle
+ *  - Block read: one address phase then N-byte sequential read
  *  - Single-byte read:  dummy write of 2 byte addr, repeated START, and 1 byte read
+ *  - Bounded waits: transfers return EEPROM_Status, stuck bus is recovered
  *
  * @date Nov. 7, 2025
  * @author William Chung + Vanessa Guzman
@@ -14,18 +17,55 @@
 #ifndef SRC_EEPROM_H_
 #define SRC_EEPROM_H_
 
+#ifndef EEPROM_SIM
 #include "stm32l4xx.h"
+#endif
 #include <stdint.h>
 
+#define EEPROM_ADDR7 0x51        //A2:A1:A0 = 0b001 -> 0x51.
 #define MAX_PLAYERS 10
 #define NAME_LEN 3
-#define EEPROM_START_ADDR 0x0000
+#define EEPROM_START_ADDR 0x0000   // v0 packed table (read for migration)
+#define LB_BANK_A_ADDR 0x0040      // leaderboard image, bank A (v1 lived here)
+#define LB_BANK_B_ADDR 0x0080      // leaderboard image, bank B
+#define LB_COMMIT_ADDR 0x00C0      // generation byte, low bit = live bank
+#define LB_NO_IMAGE 0xFF
+#define EEPROM_PAGE_SIZE 64
+#define PLAYER_REC_SIZE (NAME_LEN + 2)   // 3 initials + score hi/lo
 
 typedef struct {
     char name[NAME_LEN];
     uint16_t score;
 } Player;
 
+typedef enum {
+    EEPROM_OK = 0,
+    EEPROM_NACK,             // part did not answer (absent or busy)
+    EEPROM_TIMEOUT           // flag never came, bus was recovered
+} EEPROM_Status;
+
+// where the leaderboard image lives
+typedef enum {
+    EE_TIER_EXTERNAL = 0,    // 24LC256 only: A/B banks + journal
+    EE_TIER_INTERNAL,        // internal flash EEPROM emulation only
+    EE_TIER_TIERED           // internal flash primary, 24LC256 async backup
+} EE_Tier;
+
+// bus counters for comparing save strategies and watching bus health
+typedef struct {
+    uint32_t write_transactions; // write transactions (one per page chunk)
+    uint32_t read_transactions;  // address phase + sequential read bursts
+    uint32_t bytes_written;  // data bytes (address bytes not counted)
+    uint32_t ack_polls;      // control bytes sent while waiting on write cycle
+    uint32_t last_save_ms;   // wall time of the last saveLeaderboard()
+    uint32_t timeouts;       // flag waits that hit their deadline
+    uint32_t nacks;          // transfers NACKed by the part
+    uint32_t retries;        // transactions run again after a failure
+    uint32_t bus_recoveries; // 9-clock + STOP recoveries
+    uint32_t failures;       // transfers given up after all retries
+    uint32_t load_errors;    // boots that could not read the 24LC256 board
+} EEPROM_Stats;
+
 /**
  * @brief configure PB8 (SCL) and PB9 (SDA) for I2C1 AF4
  */
@@ -37,25 +77,117 @@ void I2C1_GPIO_Init(void);
  */
 void EEPROM_init(void);
 
+/**
+ * @brief count a timeout and recover the bus (9 SCL pulses + STOP)
+ *        used by EEPROM_async_service() after the engine aborted a
+ *        transfer; thread context only, it bit-bangs for ~100 us
+ */
+void EEPROM_bus_timeout(void);
+
 /**
  * @brief write a single byte to EEPROM at given 16-bit addr
  *
  * @param addr  16-bit memory addr (0x0000–0x7FFF)
  * @param data  data byte to write
  */
-void EEPROM_write(uint16_t addr, uint8_t data);
+EEPROM_Status EEPROM_write(uint16_t addr, uint8_t data);
+
+/**
+ * @brief write len bytes starting at addr, split on 64-byte page boundaries
+ *        one I2C transaction per page, then ACK polls until the write cycle ends
+ *
+ * @param addr  16-bit memory addr (0x0000–0x7FFF)
+ * @param buf   data to write
+ * @param len   number of bytes
+ * @return EEPROM_OK, or the error of the page that failed every retry
+ */
+EEPROM_Status EEPROM_write_page(uint16_t addr, const uint8_t *buf, uint16_t len);
 
 /**
  * @brief read a single byte from the EEPROM at  given 16-bit addr
  *
  * @param  16-bit memory addr
- * @return uint8_t  8-bit data read from EEPROM
+ * @return uint8_t  8-bit data read from EEPROM (0xFF if the read failed)
  */
 uint8_t EEPROM_read(uint16_t addr);
+
+/**
+ * @brief read len bytes starting at addr with one address phase and one
+ *        sequential read; lengths over 255 use NBYTES reload
+ *
+ * @param addr  16-bit memory addr
+ * @param buf   destination
+ * @param len   number of bytes
+ * @return EEPROM_OK, or the error of the last attempt
+ */
+EEPROM_Status EEPROM_read_block(uint16_t addr, uint8_t *buf, uint16_t len);
+/**
+ * @brief convert between Player and its 5-byte EEPROM record
+ *        [name0][name1][name2][score hi][score lo]
+ */
+void packPlayer(const Player *p, uint8_t *rec);
+void unpackPlayer(const uint8_t *rec, Player *p);
+
+/**
+ * @brief select the storage tier(s) used by save/load/addScore
+ *        (default EE_TIER_TIERED), set before loadLeaderboard
+ */
+void EEPROM_set_tier(EE_Tier tier);
+
+/**
+ * @brief write a full image of the board: internal flash tier and/or the
+ *        idle 24LC256 bank (committed, journal restarted)
+ */
 void saveLeaderboard(Player *board, uint8_t count);
+
+/**
+ * @brief stage a leaderboard save in the cache and queue the dirty pages
+ *        on the async I2C1 engine, then return
+ *
+ * @return number of page writes queued (0 = nothing changed or in flight)
+ */
+uint8_t saveLeaderboard_async(Player *board, uint8_t count);
+/**
+ * @brief load the internal flash image, or the newest valid 24LC256 bank
+ *        with the journal replayed on top; older 24LC256 layouts
+ *        (journal-only or v0 packed table) are migrated
+ *
+ * @return entry count
+ */
 uint8_t loadLeaderboard(Player *board);
 void sortLeaderboard(Player *board, uint8_t count);
+
+/**
+ * @brief slot a score would take on a sorted board (ties rank below)
+ *
+ * @return 0..count, MAX_PLAYERS or more = would not make the board
+ */
+uint8_t leaderboardRank(const Player *board, uint8_t count, uint16_t score);
+
+/**
+ * @brief insert a score into the sorted board, journal only moved slots
+ *        (RAM only; journal pages and the flash image are persisted later
+ *        by PS_service)
+ *
+ * @return new entry count
+ */
 uint8_t addScore(Player *board, uint8_t count, const char *name, uint16_t score);
+
+/**
+ * @brief write the internal flash image if addScore left it behind the
+ *        board (flashImageStale), called from PS_service
+ *
+ * @return 1 = image written, 0 = already current
+ */
+uint8_t syncFlashImage(void);
+uint8_t flashImageStale(void);
+
+/**
+ * @brief transaction/byte/timing counters since boot or last reset
+ */
+const EEPROM_Stats *EEPROM_get_stats(void);
+void EEPROM_reset_stats(void);
+
 extern Player leaderboard[MAX_PLAYERS];
 
 #endif /* SRC_EEPROM_H_ */
@@ -0,0 +1,368 @@
+/**
+ * @file eeprom_async.c
+ * @brief non-blocking I2C1 transaction engine for the 24LC256
+ *
+ *  - Write: DMA sends [AddrHi][AddrLo][Data 1..64] with AUTOEND, then the
+ *    STOPF interrupt starts ACK polls ([Dev+W] + STOP) until the part ACKs
+ *  - Read: DMA sends [AddrHi][AddrLo], TC interrupt issues repeated START,
+ *    DMA receives all bytes, TCR interrupt reloads NBYTES every 255 bytes
+ *  - One descriptor on the bus at a time, next one started from the ISR
+ *  - Each descriptor gets a get_ms() deadline and a cap on ACK polls; past
+ *    either, DMA is stopped and the xfer ends in ERROR; the bus recovery
+ *    (~100 us of bit-banging) waits for EEPROM_async_service(), which runs
+ *    it with interrupts on and holds the queue until it is done
+ *
+ * @date Dec. 2, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#ifndef EEPROM_SIM
+
+#include "eeprom_async.h"
+#include "EEPROM.h"
+#include "evloop.h"
+#include "delay.h"
+#include <string.h>
+
+#define I2C1_DMA_REQ   3u                // CxS value for I2C1 on DMA1 CH6/CH7
+#define I2C1_TX_DMA    DMA1_Channel6
+#define I2C1_RX_DMA    DMA1_Channel7
+#define I2C1_IRQ_BITS  (I2C_CR1_TCIE | I2C_CR1_STOPIE | I2C_CR1_NACKIE \
+                        | I2C_CR1_ERRIE | I2C_CR1_TXDMAEN | I2C_CR1_RXDMAEN)
+
+#define ASYNC_BASE_MS       5u          // slack on top of the estimate
+#define ASYNC_CYCLE_MS      6u          // one write cycle, 5 ms max
+#define ASYNC_BYTES_PER_MS  8u          // below the 100 kHz byte rate
+#define ASYNC_MAX_POLLS     400u        // ~10 ms of ACK polls at 400 kHz
+
+// engine phase for the descriptor on the bus
+enum {
+    PH_IDLE = 0,
+    PH_WR_DATA,     // page chunk going out
+    PH_WR_POLL,     // ACK polling for the write cycle
+    PH_RD_ADDR,     // dummy write of the 2 byte addr
+    PH_RD_DATA,     // sequential read
+    PH_RD_DRAIN     // STOP seen, DMA still moving the last byte
+};
+
+static EEPROM_Xfer *queue[EEPROM_ASYNC_QUEUE_LEN];
+static uint8_t q_head, q_tail, q_count;
+
+static EEPROM_Xfer *cur;            // descriptor on the bus, NULL when idle
+static volatile uint8_t phase;
+static volatile uint8_t locked;     // polled driver owns the bus
+static volatile uint8_t stuck;      // aborted xfer, bus recovery pending
+static uint8_t nack;                // NACKF seen during this phase
+static uint16_t offset;             // bytes of cur already completed
+static uint16_t chunk;              // bytes in the current page write
+static uint16_t rd_left;            // read bytes not yet loaded into NBYTES
+static uint32_t t_start;            // get_ms() when cur went on the bus
+static uint32_t t_limit;            // ms cur may take
+static uint16_t polls;              // ACK polls in this write cycle
+
+// TX staging: 2 address bytes + one page of data
+static uint8_t stage[2 + EEPROM_PAGE_SIZE];
+
+static void start_next(void);
+
+// one-shot DMA from memory to I2C1->TXDR
+static void dma_tx(const uint8_t *src, uint16_t n) {
+   I2C1_TX_DMA->CCR = 0;
+   I2C1_TX_DMA->CPAR = (uint32_t) &I2C1->TXDR;
+   I2C1_TX_DMA->CMAR = (uint32_t) src;
+   I2C1_TX_DMA->CNDTR = n;
+   I2C1_TX_DMA->CCR = DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_EN;
+}
+
+// one-shot DMA from I2C1->RXDR to memory, TC interrupt for PH_RD_DRAIN
+static void dma_rx(uint8_t *dst, uint16_t n) {
+   I2C1_RX_DMA->CCR = 0;
+   I2C1_RX_DMA->CPAR = (uint32_t) &I2C1->RXDR;
+   I2C1_RX_DMA->CMAR = (uint32_t) dst;
+   I2C1_RX_DMA->CNDTR = n;
+   I2C1_RX_DMA->CCR = DMA_CCR_MINC | DMA_CCR_TCIE | DMA_CCR_EN;
+}
+
+static void dma_stop(void) {
+   I2C1_TX_DMA->CCR = 0;
+   I2C1_RX_DMA->CCR = 0;
+}
+
+// [Dev+W] + STOP, NACKF tells us the write cycle is still running
+static void issue_poll(void) {
+   phase = PH_WR_POLL;
+   nack = 0;
+   I2C1->CR2 = ((EEPROM_ADDR7 << 1) & I2C_CR2_SADD) | I2C_CR2_AUTOEND
+         | I2C_CR2_START;
+}
+
+static void start_write_chunk(void) {
+   uint16_t addr = cur->addr + offset;
+   uint16_t room = EEPROM_PAGE_SIZE - (addr % EEPROM_PAGE_SIZE);
+   uint16_t left = cur->len - offset;
+   chunk = (left < room) ? left : room;
+
+   stage[0] = (uint8_t) (addr >> 8);
+   stage[1] = (uint8_t) (addr & 0xFF);
+   memcpy(&stage[2], cur->buf + offset, chunk);
+
+   phase = PH_WR_DATA;
+   nack = 0;
+   dma_tx(stage, chunk + 2);
+   I2C1->CR2 = ((EEPROM_ADDR7 << 1) & I2C_CR2_SADD)
+         | ((uint32_t) (chunk + 2) << I2C_CR2_NBYTES_Pos) | I2C_CR2_AUTOEND
+         | I2C_CR2_START;
+}
+
+static void start_read(void) {
+   stage[0] = (uint8_t) (cur->addr >> 8);
+   stage[1] = (uint8_t) (cur->addr & 0xFF);
+
+   phase = PH_RD_ADDR;
+   nack = 0;
+   dma_tx(stage, 2);
+   I2C1->CR2 = ((EEPROM_ADDR7 << 1) & I2C_CR2_SADD) | (2u << I2C_CR2_NBYTES_Pos)
+         | I2C_CR2_START;                // no AUTOEND: TC -> repeated START
+}
+
+// load the next <=255 byte read chunk into NBYTES
+static uint32_t read_cr2_bits(void) {
+   uint16_t n = (rd_left > 255u) ? 255u : rd_left;
+   rd_left -= n;
+   return ((uint32_t) n << I2C_CR2_NBYTES_Pos)
+         | (rd_left ? I2C_CR2_RELOAD : I2C_CR2_AUTOEND);
+}
+
+static void finish(uint8_t status) {
+   EEPROM_Xfer *x = cur;
+
+   dma_stop();
+   cur = 0;
+   phase = PH_IDLE;
+   x->status = status;
+   if (x->done) {
+      x->done(x);
+   }
+   ev_post(EV_EEPROM_DONE, status);
+   start_next();
+}
+
+// deadline or poll cap hit: the bus may be stuck, nothing else goes out
+// until EEPROM_async_service() has recovered it
+static void abort_cur(void) {
+   dma_stop();
+   I2C1->CR1 &= ~I2C1_IRQ_BITS;
+   stuck = 1;
+   finish(EEPROM_XFER_ERROR);
+}
+
+// worst case for the whole descriptor at the slowest bus speed
+static uint32_t xfer_limit_ms(const EEPROM_Xfer *x) {
+   uint32_t ms = ASYNC_BASE_MS + x->len / ASYNC_BYTES_PER_MS;
+   if (x->dir == EEPROM_XFER_WRITE) {
+      ms += (x->len / EEPROM_PAGE_SIZE + 2) * ASYNC_CYCLE_MS;
+   }
+   return ms;
+}
+
+static void start_next(void) {
+   if (cur || locked || stuck) {
+      return;
+   }
+   if (q_count == 0) {
+      I2C1->CR1 &= ~I2C1_IRQ_BITS;      // hand the flags back to polling
+      return;
+   }
+   cur = queue[q_head];
+   q_head = (q_head + 1) % EEPROM_ASYNC_QUEUE_LEN;
+   q_count--;
+   cur->status = EEPROM_XFER_ACTIVE;
+   offset = 0;
+   t_start = get_ms();
+   t_limit = xfer_limit_ms(cur);
+
+   I2C1->ICR = I2C_ICR_STOPCF | I2C_ICR_NACKCF;
+   I2C1->CR1 |= I2C1_IRQ_BITS;
+   if (cur->len == 0) {
+      finish(EEPROM_XFER_DONE);
+   } else if (cur->dir == EEPROM_XFER_READ) {
+      start_read();
+   } else {
+      start_write_chunk();
+   }
+}
+
+void EEPROM_async_init(void) {
+   RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+
+   // DMA1 CH6 -> I2C1_TX, CH7 -> I2C1_RX
+   DMA1_CSELR->CSELR &= ~(DMA_CSELR_C6S | DMA_CSELR_C7S);
+   DMA1_CSELR->CSELR |= (I2C1_DMA_REQ << DMA_CSELR_C6S_Pos)
+         | (I2C1_DMA_REQ << DMA_CSELR_C7S_Pos);
+   dma_stop();
+   DMA1->IFCR = DMA_IFCR_CGIF7;
+
+   q_head = q_tail = q_count = 0;
+   cur = 0;
+   phase = PH_IDLE;
+   locked = 0;
+   stuck = 0;
+
+   NVIC_SetPriority(I2C1_EV_IRQn, 3);
+   NVIC_SetPriority(I2C1_ER_IRQn, 3);
+   NVIC_SetPriority(DMA1_Channel7_IRQn, 3);
+   NVIC_EnableIRQ(I2C1_EV_IRQn);
+   NVIC_EnableIRQ(I2C1_ER_IRQn);
+   NVIC_EnableIRQ(DMA1_Channel7_IRQn);
+}
+
+uint8_t EEPROM_submit(EEPROM_Xfer *xfer) {
+   uint8_t ok = 0;
+   uint32_t primask = __get_PRIMASK();   // may be called from a callback
+   __disable_irq();
+
+   if (q_count < EEPROM_ASYNC_QUEUE_LEN && xfer->status != EEPROM_XFER_QUEUED
+         && xfer->status != EEPROM_XFER_ACTIVE) {
+      xfer->status = EEPROM_XFER_QUEUED;
+      queue[q_tail] = xfer;
+      q_tail = (q_tail + 1) % EEPROM_ASYNC_QUEUE_LEN;
+      q_count++;
+      start_next();
+      ok = 1;
+   }
+
+   __set_PRIMASK(primask);
+   return ok;
+}
+
+uint8_t EEPROM_async_pending(void) {
+   return q_count + (cur ? 1 : 0);
+}
+
+void EEPROM_async_service(void) {
+   uint32_t primask = __get_PRIMASK();
+   __disable_irq();
+   if (cur && get_ms() - t_start > t_limit) {
+      abort_cur();
+   }
+   __set_PRIMASK(primask);
+
+   if (stuck) {
+      EEPROM_bus_timeout();              // thread context, IRQs stay on
+      __disable_irq();
+      stuck = 0;
+      start_next();
+      __set_PRIMASK(primask);
+   }
+}
+
+void EEPROM_async_lock(void) {
+   while (1) {                           // let queued work finish first
+      __disable_irq();
+      if (!cur && !q_count && !stuck) {
+         locked = 1;
+         __enable_irq();
+         return;
+      }
+      __enable_irq();
+      EEPROM_async_service();            // every xfer ends by its deadline
+   }
+}
+
+void EEPROM_async_unlock(void) {
+   __disable_irq();
+   locked = 0;
+   start_next();
+   __enable_irq();
+}
+
+void I2C1_EV_IRQHandler(void) {
+   uint32_t isr = I2C1->ISR;
+
+   if (isr & I2C_ISR_NACKF) {
+      I2C1->ICR = I2C_ICR_NACKCF;
+      nack = 1;                          // hardware sends STOP after NACK
+   }
+
+   if (isr & I2C_ISR_TCR) {              // read longer than 255: reload
+      uint32_t cr2 = I2C1->CR2 & ~(I2C_CR2_NBYTES | I2C_CR2_RELOAD);
+      I2C1->CR2 = cr2 | read_cr2_bits();
+   }
+
+   if ((isr & I2C_ISR_TC) && phase == PH_RD_ADDR) {
+      I2C1_TX_DMA->CCR = 0;
+      rd_left = cur->len;
+      dma_rx(cur->buf, cur->len);
+      phase = PH_RD_DATA;
+      I2C1->CR2 = ((EEPROM_ADDR7 << 1) & I2C_CR2_SADD) | I2C_CR2_RD_WRN
+            | read_cr2_bits() | I2C_CR2_START;
+   }
+
+   if (isr & I2C_ISR_STOPF) {
+      I2C1->ICR = I2C_ICR_STOPCF;
+      if (!cur) {
+         return;
+      }
+      switch (phase) {
+      case PH_WR_DATA:
+         I2C1_TX_DMA->CCR = 0;
+         if (nack) {
+            finish(EEPROM_XFER_ERROR);
+         } else {
+            polls = 0;
+            issue_poll();                // STOP started the write cycle
+         }
+         break;
+      case PH_WR_POLL:
+         if (nack && ++polls >= ASYNC_MAX_POLLS) {
+            abort_cur();                 // part gone or stuck in its cycle
+         } else if (nack) {
+            issue_poll();                // still busy, poll again
+         } else {
+            offset += chunk;
+            if (offset < cur->len) {
+               start_write_chunk();
+            } else {
+               finish(EEPROM_XFER_DONE);
+            }
+         }
+         break;
+      case PH_RD_DATA:
+         if (nack) {
+            finish(EEPROM_XFER_ERROR);
+         } else if (I2C1_RX_DMA->CNDTR == 0) {
+            finish(EEPROM_XFER_DONE);
+         } else {
+            phase = PH_RD_DRAIN;         // last byte in flight: DMA TC ends it
+         }
+         break;
+      default:                           // NACK on the address phase
+         finish(EEPROM_XFER_ERROR);
+         break;
+      }
+   }
+}
+
+// RX DMA moved the last byte after the STOP was already seen
+void DMA1_Channel7_IRQHandler(void) {
+   DMA1->IFCR = DMA_IFCR_CGIF7;
+   if (cur && phase == PH_RD_DRAIN) {
+      finish(EEPROM_XFER_DONE);
+   }
+}
+
+void I2C1_ER_IRQHandler(void) {
+   uint32_t isr = I2C1->ISR;
+
+   I2C1->ICR = I2C_ICR_BERRCF | I2C_ICR_ARLOCF | I2C_ICR_OVRCF;
+   if (isr & (I2C_ISR_BERR | I2C_ISR_ARLO | I2C_ISR_OVR)) {
+      // toggle PE to reset the I2C state machine
+      I2C1->CR1 &= ~I2C_CR1_PE;
+      I2C1->CR1 |= I2C_CR1_PE;
+      if (cur) {
+         finish(EEPROM_XFER_ERROR);
+      }
+   }
+}
+
+#endif /* EEPROM_SIM */
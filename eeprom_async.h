@@ -0,0 +1,89 @@
+/**
+ * @file eeprom_async.h
+ * @brief Header non-blocking I2C1 transaction engine for the 24LC256
+ *
+ *  - Queue of read/write descriptors, drained by I2C1 event/error interrupts
+ *  - Data phases moved by DMA1 (CH6 = I2C1_TX, CH7 = I2C1_RX)
+ *  - Writes split on 64-byte pages, write cycle end found by ACK polling
+ *  - Completion via callback (ISR context) or polling xfer->status
+ *
+ * @date Dec. 2, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#ifndef SRC_EEPROM_ASYNC_H_
+#define SRC_EEPROM_ASYNC_H_
+
+#ifndef EEPROM_SIM
+#include "stm32l4xx.h"
+#endif
+#include <stdint.h>
+
+#define EEPROM_ASYNC_QUEUE_LEN 8
+
+typedef enum {
+    EEPROM_XFER_WRITE = 0,
+    EEPROM_XFER_READ
+} EEPROM_XferDir;
+
+typedef enum {
+    EEPROM_XFER_IDLE = 0,   // never submitted
+    EEPROM_XFER_QUEUED,     // waiting for the bus
+    EEPROM_XFER_ACTIVE,     // on the bus now
+    EEPROM_XFER_DONE,       // finished OK
+    EEPROM_XFER_ERROR       // NACK, bus error, arbitration loss or timeout
+} EEPROM_XferStatus;
+
+typedef struct EEPROM_Xfer EEPROM_Xfer;
+typedef void (*EEPROM_XferCallback)(EEPROM_Xfer *xfer);
+
+struct EEPROM_Xfer {
+    uint16_t addr;              // 16-bit memory addr
+    uint8_t *buf;               // source/destination, must live until done
+    uint16_t len;               // bytes to move
+    uint8_t dir;                // EEPROM_XferDir
+    volatile uint8_t status;    // EEPROM_XferStatus
+    EEPROM_XferCallback done;   // called from the I2C1 ISR, may be NULL
+    void *ctx;                  // free for the caller
+};
+
+/**
+ * @brief enable DMA1 CH6/CH7 request mapping and the I2C1 EV/ER interrupts
+ *        called by EEPROM_init() after I2C1 is configured
+ */
+void EEPROM_async_init(void);
+
+/**
+ * @brief queue a transfer, starts it right away if the bus is free
+ *
+ * @param xfer  descriptor, owned by the engine until status is DONE/ERROR
+ * @return 1 = queued, 0 = queue full or descriptor already in flight
+ */
+uint8_t EEPROM_submit(EEPROM_Xfer *xfer);
+
+/**
+ * @brief number of transfers queued or on the bus
+ */
+uint8_t EEPROM_async_pending(void);
+
+/**
+ * @brief drain the queue and hold the bus for blocking (polled) access
+ *        EEPROM_read/EEPROM_write use these around their register polling
+ */
+void EEPROM_async_lock(void);
+void EEPROM_async_unlock(void);
+
+/**
+ * @brief end the transfer on the bus with EEPROM_XFER_ERROR if it ran past
+ *        its deadline (stuck SDA, part gone), then recover the bus for
+ *        any transfer aborted here or by the ISR and restart the queue
+ *        called from PS_service() and while EEPROM_async_lock() waits,
+ *        never from an ISR or with interrupts masked
+ */
+void EEPROM_async_service(void);
+
+void I2C1_EV_IRQHandler(void);
+void I2C1_ER_IRQHandler(void);
+void DMA1_Channel7_IRQHandler(void);
+
+#endif /* SRC_EEPROM_ASYNC_H_ */
@@ -0,0 +1,287 @@
+/**
+ * @file eeprom_cache.c
+ * @brief write-back RAM cache of the 24LC256 leaderboard region
+ *
+ *  - One line per 64-byte EEPROM page: valid flag + dirty byte span
+ *  - Dirty span [lo..hi] is flushed with one page write, so a changed
+ *    score rewrites 2 bytes instead of the whole table
+ *  - A line stays dirty until its page write is DONE; a failed write, or
+ *    a store into the page while the write was out, keeps it dirty
+ *  - Barrier: lines marked ordered are the only ones flushed until all of
+ *    them are clean, so later stores cannot reach the part before them
+ *
+ * @date Dec. 4, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#include "eeprom_cache.h"
+#include "eeprom_async.h"
+#include "EEPROM.h"
+
+#define EE_CACHE_SIZE (EE_CACHE_PAGES * EEPROM_PAGE_SIZE)
+
+typedef struct {
+    uint8_t valid;
+    volatile uint8_t dirty;     // cleared by the flush completion (ISR)
+    volatile uint8_t rewritten; // stored into since the flush went out
+    volatile uint8_t ordered;   // behind a barrier, cleared once clean
+    uint8_t lo;                 // first dirty byte in page
+    uint8_t hi;                 // last dirty byte in page
+} CacheLine;
+
+static uint8_t cache_data[EE_CACHE_PAGES][EEPROM_PAGE_SIZE];
+static CacheLine lines[EE_CACHE_PAGES];
+static EEPROM_Xfer flush_xfer[EE_CACHE_PAGES];
+static EE_CacheStats cache_stats;
+
+static inline uint8_t in_window(uint16_t addr) {
+   return (uint16_t) (addr - EE_CACHE_BASE) < EE_CACHE_SIZE;
+}
+
+static inline uint16_t page_addr(uint8_t pg) {
+   return EE_CACHE_BASE + (uint16_t) pg * EEPROM_PAGE_SIZE;
+}
+
+// make sure page pg is in RAM; a failed read leaves the line invalid
+static EEPROM_Status fill(uint8_t pg) {
+   if (lines[pg].valid) {
+      cache_stats.hits++;
+      return EEPROM_OK;
+   }
+   cache_stats.misses++;
+   EEPROM_Status st = EEPROM_read_block(page_addr(pg), cache_data[pg],
+         EEPROM_PAGE_SIZE);
+   if (st != EEPROM_OK) {
+      cache_stats.read_errors++;
+      return st;
+   }
+   lines[pg].valid = 1;
+   lines[pg].dirty = 0;
+   return EEPROM_OK;
+}
+
+static inline uint8_t in_flight(uint8_t pg) {
+   return flush_xfer[pg].status == EEPROM_XFER_QUEUED
+         || flush_xfer[pg].status == EEPROM_XFER_ACTIVE;
+}
+
+EEPROM_Status EE_cache_prefetch(uint16_t addr, uint16_t len) {
+   EEPROM_Status st = EEPROM_OK;
+
+   if (len == 0 || !in_window(addr)) {
+      return st;
+   }
+   uint8_t first = (addr - EE_CACHE_BASE) / EEPROM_PAGE_SIZE;
+   uint16_t last = (addr - EE_CACHE_BASE + len - 1) / EEPROM_PAGE_SIZE;
+   if (last >= EE_CACHE_PAGES) {
+      last = EE_CACHE_PAGES - 1;
+   }
+   // lines are contiguous in cache_data, so each run of missing pages
+   // is filled by one sequential read
+   uint16_t pg = first;
+   while (pg <= last) {
+      if (lines[pg].valid) {
+         pg++;
+         continue;
+      }
+      uint16_t run = pg;
+      while (run <= last && !lines[run].valid) {
+         cache_stats.misses++;
+         run++;
+      }
+      st = EEPROM_read_block(page_addr(pg), cache_data[pg],
+            (run - pg) * EEPROM_PAGE_SIZE);
+      if (st != EEPROM_OK) {
+         cache_stats.read_errors++;
+         return st;                  // the run stays invalid
+      }
+      for (; pg < run; pg++) {
+         lines[pg].valid = 1;
+         lines[pg].dirty = 0;
+      }
+   }
+   return st;
+}
+
+EEPROM_Status EE_cache_read(uint16_t addr, uint8_t *buf, uint16_t len) {
+   while (len > 0) {
+      if (!in_window(addr)) {
+         return EEPROM_read_block(addr, buf, len);   // outside window
+      }
+      uint8_t pg = (addr - EE_CACHE_BASE) / EEPROM_PAGE_SIZE;
+      uint8_t off = (addr - EE_CACHE_BASE) % EEPROM_PAGE_SIZE;
+      uint16_t n = EEPROM_PAGE_SIZE - off;
+      if (n > len) {
+         n = len;
+      }
+      EEPROM_Status st = fill(pg);
+      if (st != EEPROM_OK) {
+         return st;
+      }
+      for (uint16_t i = 0; i < n; i++) {
+         buf[i] = cache_data[pg][off + i];
+      }
+      addr += n;
+      buf += n;
+      len -= n;
+   }
+   return EEPROM_OK;
+}
+
+EEPROM_Status EE_cache_write(uint16_t addr, const uint8_t *buf,
+      uint16_t len) {
+   while (len > 0) {
+      if (!in_window(addr)) {
+         return EEPROM_write_page(addr, buf, len);   // outside window
+      }
+      uint8_t pg = (addr - EE_CACHE_BASE) / EEPROM_PAGE_SIZE;
+      uint8_t off = (addr - EE_CACHE_BASE) % EEPROM_PAGE_SIZE;
+      uint16_t n = EEPROM_PAGE_SIZE - off;
+      if (n > len) {
+         n = len;
+      }
+      // the dirty span is flushed whole, so the rest of the page has to
+      // be the part's real contents
+      EEPROM_Status st = fill(pg);
+      if (st != EEPROM_OK) {
+         return st;
+      }
+      for (uint16_t i = 0; i < n; i++) {
+         uint8_t b = off + i;
+         if (cache_data[pg][b] == buf[i]) {
+            cache_stats.bytes_absorbed++;
+            continue;                         // unchanged, no wear
+         }
+         lines[pg].rewritten = 1;             // before dirty is looked at
+         cache_data[pg][b] = buf[i];
+         if (!lines[pg].dirty) {
+            lines[pg].dirty = 1;
+            lines[pg].lo = b;
+            lines[pg].hi = b;
+         } else if (b < lines[pg].lo) {
+            lines[pg].lo = b;
+         } else if (b > lines[pg].hi) {
+            lines[pg].hi = b;
+         }
+      }
+      addr += n;
+      buf += n;
+      len -= n;
+   }
+   return EEPROM_OK;
+}
+
+uint8_t EE_cache_dirty_pages(void) {
+   uint8_t n = 0;
+   for (uint8_t pg = 0; pg < EE_CACHE_PAGES; pg++) {
+      n += lines[pg].dirty;
+   }
+   return n;
+}
+
+// the span is on the part unless the page was stored into meanwhile
+static void flushed(uint8_t pg, uint16_t n, uint8_t ok) {
+   if (!ok) {
+      cache_stats.flush_errors++;         // still dirty, next flush retries
+      return;
+   }
+   cache_stats.pages_flushed++;
+   cache_stats.bytes_flushed += n;
+   if (!lines[pg].rewritten) {
+      lines[pg].dirty = 0;
+      lines[pg].ordered = 0;
+   }
+}
+
+// async completion, ISR context; ctx holds the page number
+static void flush_done(EEPROM_Xfer *x) {
+   flushed((uint8_t) (uintptr_t) x->ctx, x->len,
+         x->status == EEPROM_XFER_DONE);
+}
+
+void EE_cache_barrier(uint16_t addr, uint16_t len) {
+   for (uint8_t pg = 0; pg < EE_CACHE_PAGES; pg++) {
+      uint16_t a = page_addr(pg);
+      if (lines[pg].dirty && a < addr + len && addr < a + EEPROM_PAGE_SIZE) {
+         lines[pg].ordered = 1;
+      }
+   }
+}
+
+// 1 while a barrier page is still dirty; a line that went clean between
+// the barrier's dirty check and its store is let go here
+static uint8_t barrier_held(void) {
+   uint8_t held = 0;
+   for (uint8_t pg = 0; pg < EE_CACHE_PAGES; pg++) {
+      if (lines[pg].ordered && !lines[pg].dirty) {
+         lines[pg].ordered = 0;
+      }
+      held |= lines[pg].ordered;
+   }
+   return held;
+}
+
+EEPROM_Status EE_cache_flush(void) {
+   EEPROM_Status first_err = EEPROM_OK;
+
+   // pass 0 writes only the barrier pages if there are any, pass 1 the
+   // rest once those have landed
+   for (uint8_t pass = 0; pass < 2; pass++) {
+      uint8_t held = barrier_held();
+      for (uint8_t pg = 0; pg < EE_CACHE_PAGES; pg++) {
+         if (!lines[pg].dirty || (held && !lines[pg].ordered)) {
+            continue;
+         }
+         uint8_t lo = lines[pg].lo;
+         uint8_t n = lines[pg].hi - lo + 1;
+         lines[pg].rewritten = 0;
+         EEPROM_Status st = EEPROM_write_page(page_addr(pg) + lo,
+               &cache_data[pg][lo], n);
+         flushed(pg, n, st == EEPROM_OK);
+         if (st != EEPROM_OK && first_err == EEPROM_OK) {
+            first_err = st;
+         }
+      }
+   }
+   return first_err;
+}
+
+uint8_t EE_cache_flush_async(void) {
+   uint8_t queued = 0;
+   uint8_t held = barrier_held();
+   for (uint8_t pg = 0; pg < EE_CACHE_PAGES; pg++) {
+      if (!lines[pg].dirty || in_flight(pg)) {
+         continue;                 // in-flight page goes out on a later call
+      }
+      if (held && !lines[pg].ordered) {
+         continue;                 // waits for the barrier pages to land
+      }
+      EEPROM_Xfer *x = &flush_xfer[pg];
+      uint8_t lo = lines[pg].lo;
+      x->addr = page_addr(pg) + lo;
+      x->buf = &cache_data[pg][lo];
+      x->len = lines[pg].hi - lo + 1;
+      x->dir = EEPROM_XFER_WRITE;
+      x->done = flush_done;
+      x->ctx = (void *) (uintptr_t) pg;
+      lines[pg].rewritten = 0;
+      if (!EEPROM_submit(x)) {
+         break;                    // engine queue full
+      }
+      queued++;
+   }
+   return queued;
+}
+
+void EE_cache_invalidate(void) {
+   for (uint8_t pg = 0; pg < EE_CACHE_PAGES; pg++) {
+      lines[pg].valid = 0;
+      lines[pg].dirty = 0;
+      lines[pg].rewritten = 0;
+      lines[pg].ordered = 0;
+   }
+}
+
+const EE_CacheStats *EE_cache_get_stats(void) {
+   return &cache_stats;
+}
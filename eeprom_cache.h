@@ -0,0 +1,99 @@
+/**
+ * @file eeprom_cache.h
+ * @brief Header write-back RAM cache of the 24LC256 leaderboard region
+ *        (legacy table page + record journal)
+ *
+ *  - Mirrors EE_CACHE_PAGES pages from EE_CACHE_BASE, filled a page at a time
+ *  - Writes only touch RAM; changed bytes mark a dirty span in their page
+ *  - Flush writes only the dirty span of each dirty page (blocking or async)
+ *  - A barrier makes chosen dirty pages land before any other page
+ *  - Addresses outside the window pass straight through to the EEPROM
+ *
+ * @date Dec. 4, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#ifndef SRC_EEPROM_CACHE_H_
+#define SRC_EEPROM_CACHE_H_
+
+#ifndef EEPROM_SIM
+#include "stm32l4xx.h"
+#endif
+#include <stdint.h>
+#include "EEPROM.h"
+
+#define EE_CACHE_BASE   0x0000
+#define EE_CACHE_PAGES  64                // 0x0000-0x0FFF, 4 KB of RAM
+
+typedef struct {
+    uint32_t hits;           // page accesses served from RAM
+    uint32_t misses;         // page fills from the EEPROM
+    uint32_t pages_flushed;  // flush page writes that completed OK
+    uint32_t bytes_flushed;  // bytes those writes put on the EEPROM
+    uint32_t bytes_absorbed; // written bytes that matched RAM, never flushed
+    uint32_t read_errors;    // page fills that failed (line left invalid)
+    uint32_t flush_errors;   // page writes that failed (line kept dirty)
+} EE_CacheStats;
+
+/**
+ * @brief load every missing page in [addr, addr+len) with one sequential
+ *        read per run of missing pages
+ *
+ * @return EEPROM_OK, or the read error (pages of that run stay uncached)
+ */
+EEPROM_Status EE_cache_prefetch(uint16_t addr, uint16_t len);
+
+/**
+ * @brief read through the cache, fills missing pages with one burst each
+ *
+ * @return EEPROM_OK, or the error of the page fill that failed
+ */
+EEPROM_Status EE_cache_read(uint16_t addr, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief write into the cache, only bytes that differ are marked dirty
+ *
+ * @return EEPROM_OK, or the fill error (nothing from that page on is
+ *         written)
+ */
+EEPROM_Status EE_cache_write(uint16_t addr, const uint8_t *buf,
+      uint16_t len);
+
+/**
+ * @brief number of pages holding unflushed data
+ */
+uint8_t EE_cache_dirty_pages(void);
+
+/**
+ * @brief the dirty pages in [addr, addr+len) land before any other page:
+ *        flushes skip every other page until all of them are clean
+ *        (a page stored into later waits, pages already queued do not)
+ */
+void EE_cache_barrier(uint16_t addr, uint16_t len);
+
+/**
+ * @brief blocking flush, one page write per dirty page (barrier pages
+ *        first, the rest only if they all made it); a page whose
+ *        write fails stays dirty
+ *
+ * @return EEPROM_OK, or the first write error
+ */
+EEPROM_Status EE_cache_flush(void);
+
+/**
+ * @brief queue every dirty page on the async I2C1 engine and return (only
+ *        the barrier pages while any is dirty, the rest on a later call);
+ *        each page stays dirty until its write completes DONE
+ *
+ * @return number of page writes queued
+ */
+uint8_t EE_cache_flush_async(void);
+
+/**
+ * @brief drop all cached pages (dirty data is lost), next reads refill
+ */
+void EE_cache_invalidate(void);
+
+const EE_CacheStats *EE_cache_get_stats(void);
+
+#endif /* SRC_EEPROM_CACHE_H_ */
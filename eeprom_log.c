@@ -0,0 +1,278 @@
+/**
+ * @file eeprom_log.c
+ * @brief append-only, wear-leveled record journal on the 24LC256
+ *
+ *  - seq 0xFFFFFFFF marks a blank slot (erased part reads all 1s)
+ *  - Torn or rotted records fail the CRC-16/CCITT and end the replay
+ *  - Records left over from the previous pass carry an older seq, so the
+ *    chain check seq == seq_base + slot stops on them
+ *  - Inside a batch every record but the last has EE_LOG_MORE set in its
+ *    key byte; mount applies a batch only once its last record is there
+ *  - I/O goes through the EEPROM cache, so appends into the same page are
+ *    coalesced into one page write at flush time
+ *
+ * @date Dec. 6, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#include "eeprom_log.h"
+#include "eeprom_cache.h"
+#include <string.h>
+
+#define SEQ_BLANK 0xFFFFFFFFu
+#define NO_SLOT   0xFFFF
+
+typedef struct {
+    uint8_t used;
+    uint8_t len;
+    uint8_t data[EE_LOG_PAYLOAD];
+} LiveKey;
+
+static LiveKey live[EE_LOG_MAX_KEYS];
+static uint32_t next_seq;
+static uint16_t head;                    // next record slot to write
+static EE_LogStats log_stats;
+static EE_LogCheckpoint checkpoint_fn;
+static uint8_t mounted;                  // 0 = last mount hit a read error
+static uint8_t read_failed;              // set by read_record
+static uint8_t batching;                 // between batch_begin and batch_end
+static uint16_t open_slot;               // batch's newest record, still MORE
+static uint8_t open_rec[EE_LOG_REC_SIZE];
+
+static uint16_t crc16(const uint8_t *p, uint8_t n) {
+   uint16_t crc = 0xFFFF;
+   while (n--) {
+      crc ^= (uint16_t) (*p++) << 8;
+      for (uint8_t b = 0; b < 8; b++) {
+         crc = (crc & 0x8000) ? (uint16_t) ((crc << 1) ^ 0x1021) : (crc << 1);
+      }
+   }
+   return crc;
+}
+
+static void seal(uint8_t *rec) {
+   uint16_t crc = crc16(rec, EE_LOG_REC_SIZE - 2);
+   rec[14] = (uint8_t) crc;
+   rec[15] = (uint8_t) (crc >> 8);
+}
+
+static EEPROM_Status write_record(uint8_t key, const uint8_t *payload,
+      uint8_t len) {
+   uint8_t rec[EE_LOG_REC_SIZE];
+
+   memset(rec, 0xFF, sizeof(rec));
+   rec[0] = (uint8_t) next_seq;
+   rec[1] = (uint8_t) (next_seq >> 8);
+   rec[2] = (uint8_t) (next_seq >> 16);
+   rec[3] = (uint8_t) (next_seq >> 24);
+   rec[4] = batching ? (key | EE_LOG_MORE) : key;
+   rec[5] = len;
+   memcpy(&rec[6], payload, len);
+   seal(rec);
+
+   EEPROM_Status st = EE_cache_write(EE_LOG_START + head * EE_LOG_REC_SIZE,
+         rec, sizeof(rec));
+   if (st != EEPROM_OK) {
+      return st;                         // slot still free for a retry
+   }
+   if (batching) {
+      open_slot = head;
+      memcpy(open_rec, rec, sizeof(rec));
+   }
+   head++;
+   next_seq++;
+   log_stats.appends++;
+   return EEPROM_OK;
+}
+
+// read and validate slot i, returns its seq or SEQ_BLANK
+// (a bus error also returns SEQ_BLANK and sets read_failed)
+static uint32_t read_record(uint16_t i, uint8_t *rec) {
+   if (EE_cache_read(EE_LOG_START + i * EE_LOG_REC_SIZE, rec,
+         EE_LOG_REC_SIZE) != EEPROM_OK) {
+      read_failed = 1;
+      return SEQ_BLANK;
+   }
+   log_stats.scanned++;
+
+   uint32_t seq = rec[0] | ((uint32_t) rec[1] << 8)
+         | ((uint32_t) rec[2] << 16) | ((uint32_t) rec[3] << 24);
+   if (seq == SEQ_BLANK) {
+      return SEQ_BLANK;
+   }
+   uint16_t crc = rec[14] | ((uint16_t) rec[15] << 8);
+   if (crc != crc16(rec, EE_LOG_REC_SIZE - 2)
+         || (rec[4] & ~EE_LOG_MORE) >= EE_LOG_MAX_KEYS
+         || rec[5] > EE_LOG_PAYLOAD) {
+      log_stats.corrupt++;
+      return SEQ_BLANK;
+   }
+   return seq;
+}
+
+static void set_live(const uint8_t *rec) {
+   uint8_t key = rec[4] & ~EE_LOG_MORE;
+   live[key].used = 1;
+   live[key].len = rec[5];
+   memcpy(live[key].data, &rec[6], rec[5]);
+}
+
+static void reset_scan(void) {
+   memset(live, 0, sizeof(live));
+   head = 0;
+   log_stats.scanned = 0;
+   log_stats.corrupt = 0;
+   read_failed = 0;
+   mounted = 0;
+}
+
+static uint8_t count_live(void) {
+   uint8_t keys = 0;
+   for (uint8_t k = 0; k < EE_LOG_MAX_KEYS; k++) {
+      keys += live[k].used;
+   }
+   return keys;
+}
+
+uint8_t EE_log_mount(uint32_t seq_base) {
+   uint8_t rec[EE_LOG_REC_SIZE];
+   uint16_t end = 0;                     // slot after the last whole batch
+
+   reset_scan();
+   while (head < EE_LOG_RECORDS) {
+      if (read_record(head, rec) != seq_base + head) {
+         break;                          // blank, torn or previous pass
+      }
+      head++;
+      if (!(rec[4] & EE_LOG_MORE)) {
+         end = head;
+      }
+   }
+   if (read_failed) {
+      return EE_LOG_IO_ERROR;            // chain end unknown, stay read-only
+   }
+   // the chain is validated and cached, replay it up to the batch end;
+   // an unfinished batch is dropped and its slots written over
+   for (head = 0; head < end; head++) {
+      EE_cache_read(EE_LOG_START + head * EE_LOG_REC_SIZE, rec,
+            EE_LOG_REC_SIZE);
+      set_live(rec);
+   }
+   next_seq = seq_base + head;
+   mounted = 1;
+   return count_live();
+}
+
+uint8_t EE_log_scan_all(void) {
+   uint8_t rec[EE_LOG_REC_SIZE];
+   uint32_t best_seq[EE_LOG_MAX_KEYS];
+   uint32_t max_seq = 0;
+   uint8_t found = 0;
+
+   reset_scan();
+   if (EE_cache_prefetch(EE_LOG_START, EE_LOG_END - EE_LOG_START)
+         != EEPROM_OK) {
+      return EE_LOG_IO_ERROR;
+   }
+   for (uint16_t i = 0; i < EE_LOG_RECORDS; i++) {
+      uint32_t seq = read_record(i, rec);
+      if (read_failed) {
+         return EE_LOG_IO_ERROR;
+      }
+      if (seq == SEQ_BLANK) {
+         continue;
+      }
+      if (!found || seq > max_seq) {
+         max_seq = seq;
+         head = i + 1;                   // append right after the newest
+         found = 1;
+      }
+      uint8_t key = rec[4] & ~EE_LOG_MORE;   // no batches back then
+      if (!live[key].used || seq > best_seq[key]) {
+         set_live(rec);
+         best_seq[key] = seq;
+      }
+   }
+   next_seq = found ? max_seq + 1 : 0;
+   mounted = 1;
+   return count_live();
+}
+
+uint32_t EE_log_next_seq(void) {
+   return next_seq;
+}
+
+void EE_log_restart(void) {
+   memset(live, 0, sizeof(live));
+   head = 0;
+   open_slot = NO_SLOT;                  // batch so far is in the checkpoint
+   mounted = 1;                          // a checkpoint holds everything
+}
+
+void EE_log_batch_begin(void) {
+   batching = 1;
+   open_slot = NO_SLOT;
+}
+
+void EE_log_batch_end(void) {
+   batching = 0;
+   if (open_slot == NO_SLOT) {
+      return;                            // nothing appended
+   }
+   // still in the cache page: clear MORE on the batch's last record
+   open_rec[4] &= ~EE_LOG_MORE;
+   seal(open_rec);
+   if (EE_cache_write(EE_LOG_START + open_slot * EE_LOG_REC_SIZE, open_rec,
+         EE_LOG_REC_SIZE) != EEPROM_OK) {
+      log_stats.write_errors++;          // batch stays open, mount drops it
+   }
+   open_slot = NO_SLOT;
+}
+
+void EE_log_set_checkpoint(EE_LogCheckpoint fn) {
+   checkpoint_fn = fn;
+}
+
+uint8_t EE_log_get(uint8_t key, uint8_t *payload) {
+   if (key >= EE_LOG_MAX_KEYS || !live[key].used) {
+      return 0;
+   }
+   memcpy(payload, live[key].data, live[key].len);
+   return live[key].len;
+}
+
+uint8_t EE_log_put(uint8_t key, const uint8_t *payload, uint8_t len) {
+   if (key >= EE_LOG_MAX_KEYS || len > EE_LOG_PAYLOAD || !mounted) {
+      return 0;
+   }
+   if (live[key].used && live[key].len == len
+         && memcmp(live[key].data, payload, len) == 0) {
+      return 0;                          // nothing new to journal
+   }
+
+   if (head >= EE_LOG_RECORDS) {
+      // region full: owner checkpoints its state (which already holds
+      // the new value) and the journal starts over. Without a checkpoint
+      // the old records are all there is, so they stay; the next put
+      // tries again.
+      log_stats.compactions++;
+      if (!checkpoint_fn || checkpoint_fn() != EEPROM_OK) {
+         log_stats.checkpoint_errors++;
+         return 0;
+      }
+      EE_log_restart();
+      return 1;
+   }
+   if (write_record(key, payload, len) != EEPROM_OK) {
+      log_stats.write_errors++;
+      return 0;
+   }
+   live[key].used = 1;
+   live[key].len = len;
+   memcpy(live[key].data, payload, len);
+   return 1;
+}
+
+const EE_LogStats *EE_log_get_stats(void) {
+   return &log_stats;
+}
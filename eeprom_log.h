@@ -0,0 +1,112 @@
+/**
+ * @file eeprom_log.h
+ * @brief Header append-only, wear-leveled record journal on the 24LC256
+ *
+ *  - Fixed 16-byte records: [seq:4][key:1][len:1][payload:8][crc16:2]
+ *  - Updates append a record for one key, newest seq per key wins
+ *  - Records appended between EE_log_batch_begin/end replay all or none
+ *  - The owner keeps a checkpoint of its full state elsewhere; records
+ *    after a checkpoint start at slot 0 with seq = seq_base, seq_base+1...
+ *  - Mount replays from slot 0 until the seq chain breaks, so boot cost
+ *    follows the number of updates since the checkpoint
+ *  - When the region is full the owner's checkpoint callback runs and the
+ *    journal restarts at slot 0, so every cell takes one write per pass;
+ *    a failed checkpoint leaves the full journal in place
+ *
+ * @date Dec. 6, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#ifndef SRC_EEPROM_LOG_H_
+#define SRC_EEPROM_LOG_H_
+
+#ifndef EEPROM_SIM
+#include "stm32l4xx.h"
+#endif
+#include <stdint.h>
+#include "EEPROM.h"
+
+#define EE_LOG_START     0x0100
+#define EE_LOG_END       0x1000          // 240 records
+#define EE_LOG_REC_SIZE  16              // 4 records per 64-byte page
+#define EE_LOG_PAYLOAD   8
+#define EE_LOG_MAX_KEYS  16
+#define EE_LOG_RECORDS   ((EE_LOG_END - EE_LOG_START) / EE_LOG_REC_SIZE)
+#define EE_LOG_IO_ERROR  0xFF            // mount result: a read failed
+#define EE_LOG_MORE      0x80            // key byte: batch continues
+
+typedef struct {
+    uint32_t appends;        // records written by EE_log_put
+    uint32_t compactions;    // region wrap-arounds (checkpoints requested)
+    uint32_t scanned;        // records examined by the last mount
+    uint32_t corrupt;        // non-blank records failing CRC at mount
+    uint32_t write_errors;   // appends that failed to reach the cache
+    uint32_t checkpoint_errors; // full journal kept, checkpoint failed
+} EE_LogStats;
+
+// writes the owner's full state tagged with EE_log_next_seq();
+// EEPROM_OK only once that state is safely staged
+typedef EEPROM_Status (*EE_LogCheckpoint)(void);
+
+/**
+ * @brief replay records seq_base, seq_base+1, ... from slot 0
+ *
+ * @param seq_base  first seq after the owner's last checkpoint
+ * @return number of keys updated since that checkpoint, EE_LOG_IO_ERROR
+ *         if a read failed (appends are refused until a mount succeeds)
+ */
+uint8_t EE_log_mount(uint32_t seq_base);
+
+/**
+ * @brief journal written before checkpoints existed: scan the whole
+ *        region and keep the newest record of every key
+ *
+ * @return number of keys holding a value, or EE_LOG_IO_ERROR
+ */
+uint8_t EE_log_scan_all(void);
+
+/**
+ * @brief seq the next appended record will carry
+ */
+uint32_t EE_log_next_seq(void);
+
+/**
+ * @brief forget the live keys and append from slot 0 again
+ *        call right after persisting a checkpoint tagged EE_log_next_seq()
+ */
+void EE_log_restart(void);
+
+/**
+ * @brief group the puts in between: mount replays them all or none
+ *        (end clears EE_LOG_MORE on the last record, still in the cache)
+ */
+void EE_log_batch_begin(void);
+void EE_log_batch_end(void);
+
+/**
+ * @brief callback run by EE_log_put when the region is full; the journal
+ *        restarts only if it returns EEPROM_OK
+ */
+void EE_log_set_checkpoint(EE_LogCheckpoint fn);
+
+/**
+ * @brief latest value of key
+ *
+ * @param key      0..EE_LOG_MAX_KEYS-1
+ * @param payload  receives up to EE_LOG_PAYLOAD bytes
+ * @return payload length, 0 = key never written
+ */
+uint8_t EE_log_get(uint8_t key, uint8_t *payload);
+
+/**
+ * @brief append a new value for key (skipped if identical to the live one)
+ *
+ * @return 1 = record appended (or folded into a checkpoint), 0 =
+ *         unchanged, bad argument, journal not mounted, the write failed
+ *         or the region is full and the checkpoint failed
+ */
+uint8_t EE_log_put(uint8_t key, const uint8_t *payload, uint8_t len);
+
+const EE_LogStats *EE_log_get_stats(void);
+
+#endif /* SRC_EEPROM_LOG_H_ */
@@ -0,0 +1,316 @@
+/**
+ * @file eeprom_sim.c
+ * @brief host-side model of I2C1 + 24LC256 (build with -DEEPROM_SIM)
+ *
+ *  - Time is kept in ns so 1 MHz bit times add up without rounding
+ *  - Array writes land byte by byte at STOP, so a power cut can stop
+ *    a page write part way through
+ *  - Replaces delay.c (get_ms) and eeprom_async.c in the host build
+ *
+ * @date Dec. 15, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#ifdef EEPROM_SIM
+
+#include "eeprom_sim.h"
+#include "eeprom_async.h"
+#include "delay.h"
+#include <string.h>
+
+static uint8_t mem[EE_SIM_SIZE];
+static uint32_t wear[EE_SIM_PAGES];
+static uint16_t pointer;                 // internal address counter
+static uint64_t now_ns;
+static uint64_t busy_until_ns;           // end of the running write cycle
+static uint32_t bit_ns;
+
+static EEPROM_Status fault;
+static uint8_t fault_count;
+static uint8_t stuck;                    // SDA held low until recovery
+static uint8_t power_cut_armed;         // CUT_BYTES or CUT_WRITES
+static uint32_t power_budget;            // bytes/page writes before the cut
+static uint8_t powered;
+
+// async stand-in, hold mode only
+static EEPROM_Xfer *a_queue[EEPROM_ASYNC_QUEUE_LEN];
+static uint8_t a_head, a_count;
+static uint8_t a_hold;
+static uint8_t a_running;                // transfer in EEPROM_write_page
+static uint8_t a_stage[EEPROM_PAGE_SIZE];
+static uint16_t a_chunk;                 // bytes of a_stage in use
+
+volatile uint32_t g_ms_ticks;
+
+enum { CUT_OFF = 0, CUT_BYTES, CUT_WRITES };
+
+static void bus_time(uint32_t bits) {
+   now_ns += (uint64_t) bits * bit_ns;
+   g_ms_ticks = (uint32_t) (now_ns / 1000000u);
+}
+
+// START + n bytes with their ACK bits + STOP
+static void bus_frame(uint32_t bytes) {
+   bus_time(1 + bytes * 9 + 1);
+}
+
+// a fault queued by EE_sim_fail_next, or a bus still stuck
+static EEPROM_Status take_fault(void) {
+   if (stuck) {
+      bus_frame(1);
+      return EEPROM_TIMEOUT;
+   }
+   if (fault_count) {
+      fault_count--;
+      if (fault == EEPROM_TIMEOUT) {
+         stuck = 1;
+      }
+      bus_frame(1);
+      return fault;
+   }
+   return EEPROM_OK;
+}
+
+void EE_sim_reset(void) {
+   memset(mem, 0xFF, sizeof(mem));
+   memset(wear, 0, sizeof(wear));
+   pointer = 0;
+   now_ns = 0;
+   busy_until_ns = 0;
+   g_ms_ticks = 0;
+   fault_count = 0;
+   stuck = 0;
+   power_cut_armed = CUT_OFF;
+   powered = 1;
+   EE_sim_async_hold(0);
+   EE_sim_set_bus_khz(400);
+}
+
+void EE_sim_set_bus_khz(uint16_t khz) {
+   bit_ns = 1000000u / khz;
+}
+
+EEPROM_Status EE_sim_i2c_write(const uint8_t *bytes, uint16_t n) {
+   EEPROM_Status st = take_fault();
+   if (st != EEPROM_OK) {
+      return st;
+   }
+   if (!powered || now_ns < busy_until_ns) {
+      bus_frame(1);                      // control byte NACKed
+      return EEPROM_NACK;
+   }
+   bus_frame(1 + n);
+   if (n < 2) {
+      return EEPROM_OK;                  // ACK poll
+   }
+   pointer = ((uint16_t) (bytes[0] << 8) | bytes[1]) & (EE_SIM_SIZE - 1);
+   if (n == 2) {
+      return EEPROM_OK;                  // address phase of a read
+   }
+   if (power_cut_armed == CUT_WRITES) {
+      if (power_budget == 0) {
+         powered = 0;                    // gone before this page write
+         return EEPROM_NACK;
+      }
+      power_budget--;
+   }
+
+   // data latches into the page buffer, address wraps inside the page
+   uint16_t page = pointer & ~(EEPROM_PAGE_SIZE - 1);
+   uint8_t offset = pointer & (EEPROM_PAGE_SIZE - 1);
+   for (uint16_t i = 2; i < n; i++) {
+      if (power_cut_armed == CUT_BYTES) {
+         if (power_budget == 0) {
+            powered = 0;                 // rest of the page never lands
+            break;
+         }
+         power_budget--;
+      }
+      mem[page + offset] = bytes[i];
+      offset = (offset + 1) & (EEPROM_PAGE_SIZE - 1);
+   }
+   pointer = page + offset;
+   wear[page / EEPROM_PAGE_SIZE]++;
+   busy_until_ns = now_ns + (uint64_t) EE_SIM_TWC_US * 1000u;
+   return EEPROM_OK;
+}
+
+EEPROM_Status EE_sim_i2c_read(uint8_t *buf, uint16_t n) {
+   EEPROM_Status st = take_fault();
+   if (st != EEPROM_OK) {
+      return st;
+   }
+   if (!powered || now_ns < busy_until_ns) {
+      bus_frame(1);
+      return EEPROM_NACK;
+   }
+   bus_frame(1 + n);
+   for (uint16_t i = 0; i < n; i++) {   // sequential read rolls over the array
+      buf[i] = mem[pointer];
+      pointer = (pointer + 1) & (EE_SIM_SIZE - 1);
+   }
+   return EEPROM_OK;
+}
+
+void EE_sim_bus_recover(void) {
+   bus_time(9 * 2 + 2);                  // 9 clocks + STOP at bit speed
+   stuck = 0;
+}
+
+uint64_t EE_sim_time_us(void) {
+   return now_ns / 1000u;
+}
+
+void EE_sim_advance_us(uint32_t us) {
+   now_ns += (uint64_t) us * 1000u;
+   g_ms_ticks = (uint32_t) (now_ns / 1000000u);
+}
+
+void EE_sim_fail_next(EEPROM_Status st, uint8_t count) {
+   fault = st;
+   fault_count = count;
+}
+
+void EE_sim_power_cut_after(uint32_t bytes) {
+   power_cut_armed = CUT_BYTES;
+   power_budget = bytes;
+}
+
+void EE_sim_power_cut_at_write(uint32_t writes) {
+   power_cut_armed = CUT_WRITES;
+   power_budget = writes;
+}
+
+void EE_sim_power_on(void) {
+   power_cut_armed = CUT_OFF;
+   powered = 1;
+   busy_until_ns = 0;
+   stuck = 0;
+}
+
+uint8_t EE_sim_powered(void) {
+   return powered;
+}
+
+void EE_sim_flip(uint16_t addr, uint8_t mask) {
+   mem[addr & (EE_SIM_SIZE - 1)] ^= mask;
+}
+
+uint32_t EE_sim_page_writes(uint16_t page) {
+   return (page < EE_SIM_PAGES) ? wear[page] : 0;
+}
+
+uint32_t EE_sim_max_page_writes(void) {
+   uint32_t max = 0;
+   for (uint16_t p = 0; p < EE_SIM_PAGES; p++) {
+      if (wear[p] > max) {
+         max = wear[p];
+      }
+   }
+   return max;
+}
+
+uint8_t *EE_sim_array(void) {
+   return mem;
+}
+
+/* delay.c stand-in: the simulated clock is the ms timebase */
+
+uint32_t get_ms(void) {
+   return g_ms_ticks;
+}
+
+/* eeprom_async.c stand-in: a transfer completes inside submit, or in
+ * hold mode waits in a queue for EE_sim_async_step() */
+
+// on the bus: a write's first page chunk is copied now, like stage[]
+static void a_start(EEPROM_Xfer *x) {
+   x->status = EEPROM_XFER_ACTIVE;
+   if (x->dir == EEPROM_XFER_WRITE) {
+      uint16_t room = EEPROM_PAGE_SIZE - (x->addr % EEPROM_PAGE_SIZE);
+      a_chunk = (x->len < room) ? x->len : room;
+      memcpy(a_stage, x->buf, a_chunk);
+   }
+}
+
+static void a_run(EEPROM_Xfer *x) {
+   EEPROM_Status st;
+
+   a_running = 1;
+   if (x->dir == EEPROM_XFER_READ) {
+      st = EEPROM_read_block(x->addr, x->buf, x->len);
+   } else {
+      st = EEPROM_write_page(x->addr, a_stage, a_chunk);
+      if (st == EEPROM_OK && x->len > a_chunk) {
+         st = EEPROM_write_page(x->addr + a_chunk, x->buf + a_chunk,
+               x->len - a_chunk);
+      }
+   }
+   a_running = 0;
+   x->status = (st == EEPROM_OK) ? EEPROM_XFER_DONE : EEPROM_XFER_ERROR;
+   if (x->done) {
+      x->done(x);
+   }
+}
+
+void EE_sim_async_hold(uint8_t on) {
+   while (a_count) {                     // reset: the queue is RAM
+      a_queue[a_head]->status = EEPROM_XFER_IDLE;
+      a_head = (a_head + 1) % EEPROM_ASYNC_QUEUE_LEN;
+      a_count--;
+   }
+   a_head = 0;
+   a_hold = on;
+}
+
+uint8_t EE_sim_async_step(void) {
+   if (a_count == 0) {
+      return 0;
+   }
+   EEPROM_Xfer *x = a_queue[a_head];
+   a_head = (a_head + 1) % EEPROM_ASYNC_QUEUE_LEN;
+   a_count--;
+   a_run(x);
+   if (a_count && a_queue[a_head]->status == EEPROM_XFER_QUEUED) {
+      a_start(a_queue[a_head]);
+   }
+   return 1;
+}
+
+void EEPROM_async_init(void) {
+}
+
+uint8_t EEPROM_submit(EEPROM_Xfer *xfer) {
+   if (!a_hold) {
+      a_start(xfer);
+      a_run(xfer);
+      return 1;
+   }
+   if (a_count == EEPROM_ASYNC_QUEUE_LEN || xfer->status == EEPROM_XFER_QUEUED
+         || xfer->status == EEPROM_XFER_ACTIVE) {
+      return 0;
+   }
+   xfer->status = EEPROM_XFER_QUEUED;
+   a_queue[(a_head + a_count) % EEPROM_ASYNC_QUEUE_LEN] = xfer;
+   if (a_count++ == 0) {
+      a_start(xfer);
+   }
+   return 1;
+}
+
+uint8_t EEPROM_async_pending(void) {
+   return a_count;
+}
+
+void EEPROM_async_service(void) {
+}
+
+void EEPROM_async_lock(void) {
+   while (!a_running && EE_sim_async_step()) {
+   }
+}
+
+void EEPROM_async_unlock(void) {
+}
+
+#endif /* EEPROM_SIM */
@@ -0,0 +1,119 @@
+/**
+ * @file eeprom_sim.h
+ * @brief Header host-side model of I2C1 + 24LC256 (build with -DEEPROM_SIM)
+ *
+ *  - 32 KB array, erased to 0xFF; writes wrap inside their 64-byte page
+ *  - A write transaction with data starts a 5 ms write cycle, the control
+ *    byte is NACKed until it ends (ACK polling works as on the part)
+ *  - Simulated clock advanced by bus time (START, 9 bits per byte, STOP)
+ *    at 100, 400 or 1000 kHz and by the write cycle; get_ms() reads it
+ *  - Fault injection: NACK/stuck-bus on the next transactions, power cut
+ *    after N array bytes (torn page), bit flips
+ *  - Per-page write counters for wear
+ *  - Also stands in for the async engine: EEPROM_submit() runs the
+ *    transfer at once and completes it before returning, or, in hold
+ *    mode, queues it like the I2C1 engine and EE_sim_async_step() ends
+ *    the one on the bus
+ *
+ * @date Dec. 15, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#ifndef SRC_EEPROM_SIM_H_
+#define SRC_EEPROM_SIM_H_
+
+#include <stdint.h>
+#include "EEPROM.h"
+
+#define EE_SIM_SIZE       0x8000
+#define EE_SIM_PAGES      (EE_SIM_SIZE / EEPROM_PAGE_SIZE)
+#define EE_SIM_TWC_US     5000            // write cycle, datasheet max
+
+/**
+ * @brief erase the array, clear wear counters and faults, clock to 0,
+ *        bus at 400 kHz, async transfers complete inside EEPROM_submit()
+ */
+void EE_sim_reset(void);
+
+/**
+ * @brief SCL frequency used for bus time (100, 400 or 1000)
+ */
+void EE_sim_set_bus_khz(uint16_t khz);
+
+/**
+ * @brief one write transaction: [Dev+W] then n bytes then STOP
+ *        2 bytes = address only (sets the pointer, no write cycle),
+ *        0 bytes = ACK poll
+ */
+EEPROM_Status EE_sim_i2c_write(const uint8_t *bytes, uint16_t n);
+
+/**
+ * @brief one sequential read from the address pointer: [Dev+R] n bytes
+ */
+EEPROM_Status EE_sim_i2c_read(uint8_t *buf, uint16_t n);
+
+/**
+ * @brief 9 SCL pulses + STOP, clears a stuck bus
+ */
+void EE_sim_bus_recover(void);
+
+/**
+ * @brief simulated time since reset, and idle time passing
+ */
+uint64_t EE_sim_time_us(void);
+void EE_sim_advance_us(uint32_t us);
+
+/**
+ * @brief make the next count transactions fail with st
+ *        (EEPROM_TIMEOUT = bus stuck until EE_sim_bus_recover)
+ */
+void EE_sim_fail_next(EEPROM_Status st, uint8_t count);
+
+/**
+ * @brief power drops after bytes more array bytes are written: the page
+ *        write in progress is torn and later writes are lost
+ *        EE_sim_power_on() brings the part back (array contents kept)
+ */
+void EE_sim_power_cut_after(uint32_t bytes);
+
+/**
+ * @brief power drops after writes more page writes, between two of them
+ *        (no page torn)
+ */
+void EE_sim_power_cut_at_write(uint32_t writes);
+void EE_sim_power_on(void);
+uint8_t EE_sim_powered(void);
+
+/**
+ * @brief xor mask into the byte at addr (bit rot)
+ */
+void EE_sim_flip(uint16_t addr, uint8_t mask);
+
+/**
+ * @brief write cycles seen by a 64-byte page, and the worst page
+ */
+uint32_t EE_sim_page_writes(uint16_t page);
+uint32_t EE_sim_max_page_writes(void);
+
+/**
+ * @brief the array itself, for snapshots and dumps
+ */
+uint8_t *EE_sim_array(void);
+
+/**
+ * @brief hold mode: EEPROM_submit() queues, the head transfer copies its
+ *        first page chunk when it goes on the bus (as the engine's stage
+ *        buffer does) and stays there until EE_sim_async_step();
+ *        EEPROM_async_lock() drains the queue first, as on target
+ *        turning it off drops whatever is still queued (a reset)
+ */
+void EE_sim_async_hold(uint8_t on);
+
+/**
+ * @brief finish the transfer on the bus and start the next one
+ *
+ * @return 1 = a transfer finished, 0 = queue empty
+ */
+uint8_t EE_sim_async_step(void);
+
+#endif /* SRC_EEPROM_SIM_H_ */
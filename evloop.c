@@ -0,0 +1,356 @@
+/*
+------------------------------------------------------------------------------
+evloop.c
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 evloop.c
+******************************************************************************
+* @file           : evloop.c
+* @brief          : run-to-completion event loop with a hierarchical timer
+*                   wheel
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/28/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2
+* wiring       	  : n/a
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/28/2025      :	Created file
+* 12/29/2025      :	Sleeps through pm_idle (Stop 2 when the wheel allows)
+******************************************************************************
+*/
+
+#include "evloop.h"
+#include "delay.h"
+#include "swtimer.h"
+#include "lowpower.h"
+
+#define Q_MASK     (EV_QUEUE_LEN - 1)
+#define SLOTS      (1u << EV_WHEEL_BITS)
+#define SLOT_MASK  (SLOTS - 1)
+#define SPAN       (1u << (EV_WHEEL_BITS * EV_WHEEL_LEVELS))
+#define PENDING    0xFF              // level of a timer about to fire
+
+// interrupts and the loop both post, so the queue is guarded by PRIMASK
+static EV_Event queue[EV_QUEUE_LEN];
+static uint8_t q_head, q_tail;
+static EV_Handler handlers[EV_TYPE_COUNT];
+static EV_IdleFn idle_fn;
+static EV_Stats ev_stats;
+
+// Timer wheel, loop context only. Level l slot s holds timers due in
+// the 2^(6l)-tick block s; a level-l slot is cascaded (re-added one level
+// down) when the tick count enters its block. Bitmaps of occupied slots
+// make the next deadline a few ctz operations.
+static EV_Timer *wheel[EV_WHEEL_LEVELS][SLOTS];
+static uint64_t occupied[EV_WHEEL_LEVELS];
+static uint32_t wheel_now;           // last tick (ms) processed
+static SWT_Timer wake_timer;         // TIM2 compare wakes WFI on time
+
+void ev_init(void) {
+   wheel_now = get_ms();
+}
+
+void ev_on(EV_Type type, EV_Handler fn) {
+   handlers[type] = fn;
+}
+
+// runs each loop pass that finds the queue empty, before sleeping;
+// returning nonzero skips the sleep so background work keeps going
+void ev_set_idle(EV_IdleFn fn) {
+   idle_fn = fn;
+}
+
+/*
+ * Function 1: ev_post
+ * --------------------
+ * queues an event; safe from interrupts and from handlers
+ *
+ *	takes in: type, arg
+ *
+ *  returns: 1 = queued, 0 = queue full (counted as dropped)
+ */
+uint8_t ev_post(EV_Type type, uint32_t arg) {
+   uint32_t primask = __get_PRIMASK();
+   __disable_irq();
+   uint8_t depth = (uint8_t) (q_head - q_tail);
+   if (depth >= EV_QUEUE_LEN) {
+      ev_stats.dropped++;
+      __set_PRIMASK(primask);
+      return 0;
+   }
+   queue[q_head & Q_MASK].type = type;
+   queue[q_head & Q_MASK].arg = arg;
+   queue[q_head & Q_MASK].t_us = get_us();
+   q_head++;
+   ev_stats.posted++;
+   ev_stats.depth = depth + 1;
+   if (ev_stats.depth > ev_stats.max_depth)
+      ev_stats.max_depth = ev_stats.depth;
+   __set_PRIMASK(primask);
+   return 1;
+}
+
+static uint8_t pop(EV_Event *ev) {
+   uint8_t got = 0;
+   __disable_irq();
+   if (q_head != q_tail) {
+      *ev = queue[q_tail & Q_MASK];
+      q_tail++;
+      ev_stats.depth = (uint8_t) (q_head - q_tail);
+      got = 1;
+   }
+   __enable_irq();
+   return got;
+}
+
+static void account(EV_Type type, uint32_t t0) {
+   EV_HandlerStats *hs = &ev_stats.handler[type];
+   uint32_t dt = get_us() - t0;
+   hs->calls++;
+   hs->total_us += dt;
+   if (dt > hs->max_us)
+      hs->max_us = dt;
+}
+
+// ------------------------------------------------------------- wheel --
+
+static void link(EV_Timer **head, EV_Timer *t) {
+   t->next = *head;
+   if (t->next)
+      t->next->pprev = &t->next;
+   t->pprev = head;
+   *head = t;
+}
+
+static void unlink(EV_Timer *t) {
+   *t->pprev = t->next;
+   if (t->next)
+      t->next->pprev = t->pprev;
+   if (t->level != PENDING && !wheel[t->level][t->slot])
+      occupied[t->level] &= ~(1ull << t->slot);
+   t->pprev = 0;
+}
+
+// O(1): the level comes from how far out the timer is
+static void wheel_add(EV_Timer *t) {
+   uint32_t delta = t->expires - wheel_now;
+   uint32_t at = t->expires;
+   if ((int32_t) delta < 0) {
+      t->expires = wheel_now + 1;    // late: fire on the next tick
+      delta = 1;
+      at = t->expires;
+   } else if (delta >= SPAN) {
+      delta = SPAN - 1;              // parked at the far end, re-cascades
+      at = wheel_now + delta;
+   }
+   uint8_t level = 0;
+   while (level < EV_WHEEL_LEVELS - 1
+         && delta >= (1u << ((level + 1) * EV_WHEEL_BITS)))
+      level++;
+   t->level = level;
+   t->slot = (at >> (level * EV_WHEEL_BITS)) & SLOT_MASK;
+   link(&wheel[level][t->slot], t);
+   occupied[level] |= 1ull << t->slot;
+}
+
+static void cascade(uint8_t level, uint8_t slot) {
+   while (wheel[level][slot]) {
+      EV_Timer *t = wheel[level][slot];
+      unlink(t);
+      wheel_add(t);
+      ev_stats.cascades++;
+   }
+}
+
+// one tick: cascade the blocks just entered, then fire slot 0 timers
+static void wheel_tick(void) {
+   EV_Timer *due = 0;
+
+   wheel_now++;
+   for (uint8_t l = 1; l < EV_WHEEL_LEVELS; l++) {
+      if (wheel_now & ((1u << (l * EV_WHEEL_BITS)) - 1))
+         break;
+      cascade(l, (wheel_now >> (l * EV_WHEEL_BITS)) & SLOT_MASK);
+   }
+
+   // move this tick's timers to a local list first, so callbacks can
+   // start or stop any timer (including ones still waiting to fire)
+   uint8_t s = wheel_now & SLOT_MASK;
+   while (wheel[0][s]) {
+      EV_Timer *t = wheel[0][s];
+      unlink(t);
+      if (t->expires != wheel_now) {
+         wheel_add(t);               // parked timer, not due yet
+         continue;
+      }
+      t->level = PENDING;
+      link(&due, t);
+   }
+   while (due) {
+      EV_Timer *t = due;
+      unlink(t);
+      if (t->period) {
+         t->expires += t->period;
+         wheel_add(t);
+      }
+      ev_stats.timers_fired++;
+      uint32_t t0 = get_us();
+      t->fn(t->arg);
+      account(EV_TIMER, t0);
+   }
+}
+
+static inline uint8_t first_after(uint64_t bits, uint8_t cur) {
+   uint8_t r = (cur + 1) & SLOT_MASK;
+   uint64_t rot = r ? (bits >> r) | (bits << (SLOTS - r)) : bits;
+   return (uint8_t) __builtin_ctzll(rot) + 1;   // 1..64 slots ahead
+}
+
+/*
+ * Function 2: ev_timer_next
+ * --------------------
+ * earliest tick the wheel has work at: a level 0 expiry (exact) or the
+ *    cascade of an occupied higher slot (lower bound, may be early)
+ *
+ *	takes in: tick - receives the tick
+ *
+ *  returns: 1 = found, 0 = no timers running
+ */
+uint8_t ev_timer_next(uint32_t *tick) {
+   uint8_t found = 0;
+   uint32_t best = 0;
+   for (uint8_t l = 0; l < EV_WHEEL_LEVELS; l++) {
+      if (!occupied[l])
+         continue;
+      uint8_t shift = l * EV_WHEEL_BITS;
+      uint32_t block = wheel_now >> shift;
+      uint32_t at = (block + first_after(occupied[l], block & SLOT_MASK))
+            << shift;
+      if (!found || (int32_t) (at - best) < 0)
+         best = at;
+      found = 1;
+   }
+   *tick = best;
+   return found;
+}
+
+// catch up to target, jumping over stretches with nothing to do
+static void wheel_advance(uint32_t target) {
+   while ((int32_t) (target - wheel_now) > 0) {
+      uint32_t next;
+      if (!ev_timer_next(&next) || (int32_t) (next - target) > 0) {
+         wheel_now = target;
+         return;
+      }
+      wheel_now = next - 1;
+      wheel_tick();
+   }
+}
+
+/*
+ * Function 3: ev_timer_start
+ * --------------------
+ * (re)starts t from the loop: fn(arg) runs in the loop delay_ms from
+ *    now, then every period_ms if not 0. Not for use in interrupts.
+ *
+ *	takes in: t, delay_ms, period_ms, fn, arg
+ *
+ *  returns: nothing
+ */
+void ev_timer_start(EV_Timer *t, uint32_t delay_ms, uint32_t period_ms,
+      EV_TimerFn fn, void *arg) {
+   if (t->pprev)
+      unlink(t);
+   t->expires = wheel_now + (delay_ms ? delay_ms : 1);
+   t->period = period_ms;
+   t->fn = fn;
+   t->arg = arg;
+   wheel_add(t);
+}
+
+void ev_timer_stop(EV_Timer *t) {
+   if (t->pprev)
+      unlink(t);
+}
+
+uint8_t ev_timer_active(const EV_Timer *t) {
+   return t->pprev != 0;
+}
+
+// -------------------------------------------------------------- loop --
+
+static void wake(void *arg) {
+   (void) arg;                       // the interrupt itself ends WFI
+}
+
+// advance the wheel and run one queued event, 0 = queue was empty
+static uint8_t dispatch_one(void) {
+   EV_Event ev;
+
+   wheel_advance(get_ms());
+   if (!pop(&ev))
+      return 0;
+   if (!handlers[ev.type]) {
+      ev_stats.unhandled++;
+      return 1;
+   }
+   uint32_t t0 = get_us();
+   handlers[ev.type](&ev);
+   account((EV_Type) ev.type, t0);
+   return 1;
+}
+
+/*
+ * Function 4: ev_run_once
+ * --------------------
+ * one pass: advance the wheel to get_ms(), then run one queued event
+ *    to completion; with nothing queued, run the idle hook and sleep
+ *    (WFI) until an interrupt or the next wheel deadline
+ *
+ *	takes in: nothing
+ *
+ *  returns: nothing
+ */
+void ev_run_once(void) {
+   if (dispatch_one())
+      return;
+
+   ev_stats.idle_calls++;
+   if (idle_fn && idle_fn())
+      return;                        // background work still pending
+
+   uint32_t next;
+   if (ev_timer_next(&next)) {
+      int32_t ms = (int32_t) (next - get_ms());
+      swt_start_ms(&wake_timer, ms > 0 ? ms : 0, 0, wake, 0);
+   } else {
+      swt_stop(&wake_timer);
+   }
+   __disable_irq();
+   if (q_head == q_tail)
+      pm_idle();                     // a pending interrupt still wakes it
+   __enable_irq();
+}
+
+// same pass without the idle hook or the sleep, for callers that have
+// their own work to interleave
+void ev_poll(void) {
+   dispatch_one();
+}
+
+void ev_run(void) {
+   while (1)
+      ev_run_once();
+}
+
+const EV_Stats *ev_get_stats(void) {
+   return &ev_stats;
+}
@@ -0,0 +1,104 @@
+/*
+------------------------------------------------------------------------------
+evloop.h
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 evloop.h
+******************************************************************************
+* @file           : evloop.h
+* @brief          : header for evloop.c (event queue + timer wheel loop)
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/28/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2
+* wiring       	  : n/a
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/28/2025      :	Created file
+******************************************************************************
+*/
+
+// ------------------------------------------------ #includes for evloop.c --
+#ifndef EVLOOP_H
+#define EVLOOP_H
+
+#include "stm32l4xx_hal.h"
+#include <stdint.h>
+
+#define EV_QUEUE_LEN   32           // power of two
+#define EV_WHEEL_BITS  6            // 64 slots per level
+#define EV_WHEEL_LEVELS 3           // 1 ms, 64 ms, 4.096 s slots (~262 s)
+
+typedef enum {
+   EV_TIMER = 0,                    // wheel timer callbacks (stats only)
+   EV_BUTTON,                       // arg = color code 1..5 (EXTI)
+   EV_KEY,                          // arg = byte received (LPUART1 RX)
+   EV_PLAYBACK_DONE,                // LED sequence finished
+   EV_EEPROM_DONE,                  // async I2C1 transfer finished, arg = status
+   EV_TYPE_COUNT
+} EV_Type;
+
+typedef struct {
+   uint8_t type;
+   uint32_t arg;
+   uint32_t t_us;                   // get_us() when posted
+} EV_Event;
+
+// runs to completion in the loop, never in an interrupt
+typedef void (*EV_Handler)(const EV_Event *ev);
+typedef void (*EV_TimerFn)(void *arg);
+typedef uint8_t (*EV_IdleFn)(void);   // nonzero = more idle work, don't sleep
+
+// owned by the caller, linked into a wheel slot while running
+typedef struct EV_Timer {
+   struct EV_Timer *next;
+   struct EV_Timer **pprev;
+   uint32_t expires;                // wheel tick (ms) it fires at
+   uint32_t period;                 // 0 = one-shot
+   EV_TimerFn fn;
+   void *arg;
+   uint8_t level;
+   uint8_t slot;
+} EV_Timer;
+
+typedef struct {
+   uint32_t calls;
+   uint32_t total_us;
+   uint32_t max_us;
+} EV_HandlerStats;
+
+typedef struct {
+   uint32_t posted;
+   uint32_t dropped;                // queue full
+   uint32_t unhandled;              // no handler for the type
+   uint32_t timers_fired;
+   uint32_t cascades;               // timers moved down a wheel level
+   uint32_t idle_calls;
+   uint8_t depth;
+   uint8_t max_depth;
+   EV_HandlerStats handler[EV_TYPE_COUNT];
+} EV_Stats;
+
+// ---------- Function Prototypes --------------------------------------------
+void ev_init(void);
+void ev_on(EV_Type type, EV_Handler fn);
+void ev_set_idle(EV_IdleFn fn);
+uint8_t ev_post(EV_Type type, uint32_t arg);
+void ev_timer_start(EV_Timer *t, uint32_t delay_ms, uint32_t period_ms,
+      EV_TimerFn fn, void *arg);
+void ev_timer_stop(EV_Timer *t);
+uint8_t ev_timer_active(const EV_Timer *t);
+uint8_t ev_timer_next(uint32_t *tick);
+void ev_run_once(void);
+void ev_poll(void);
+void ev_run(void);
+const EV_Stats *ev_get_stats(void);
+
+#endif // EVLOOP_H
@@ -0,0 +1,255 @@
+/**
+ * @file flash_ee.c
+ * @brief EEPROM emulation in STM32L4A6 internal flash
+ *
+ *  - Double-word programming (the L4 minimum, ECC is per double word)
+ *  - Erased double word = all 1s, which is never a valid record since
+ *    vword and ~vword would match
+ *  - A crash during a page swap leaves the new page without its header,
+ *    so mount keeps using the old page
+ *  - Host build (EEPROM_SIM): pages in RAM, program/erase times from the
+ *    datasheet charged to the simulated clock
+ *
+ * @date Dec. 18, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#include "flash_ee.h"
+#include <string.h>
+
+#define FEE_MAGIC     0x45454D55u        // "UMEE"
+#define REC_TAG       0xA5u
+#define WORD_BLANK    0xFFFFFFFFu
+#define FLASH_KEY1    0x45670123u
+#define FLASH_KEY2    0xCDEF89ABu
+
+#ifdef EEPROM_SIM
+#include "eeprom_sim.h"
+#define SIM_PROG_US   82                 // 64-bit program, typ
+#define SIM_ERASE_US  22000              // page erase, typ
+static uint32_t sim_flash[2][FEE_PAGE_SIZE / 4];
+#endif
+
+static uint32_t mirror[FEE_VWORDS];
+static uint8_t active;                   // 0 = page A, 1 = page B
+static uint16_t next_slot;               // next free record in active page
+static uint32_t gen;
+static FEE_Stats fee_stats;
+
+static const uint32_t *page_ptr(uint8_t page) {
+#ifdef EEPROM_SIM
+   return sim_flash[page];
+#else
+   return (const uint32_t *) (page ? FEE_PAGE_B : FEE_PAGE_A);
+#endif
+}
+
+static uint8_t crc8(const uint8_t *p, uint8_t n) {
+   uint8_t crc = 0;
+   while (n--) {
+      crc ^= *p++;
+      for (uint8_t b = 0; b < 8; b++) {
+         crc = (crc & 0x80) ? (uint8_t) ((crc << 1) ^ 0x07) : (crc << 1);
+      }
+   }
+   return crc;
+}
+
+static uint32_t rec_hi(uint8_t vword, uint32_t data) {
+   uint8_t b[5] = { (uint8_t) data, (uint8_t) (data >> 8),
+         (uint8_t) (data >> 16), (uint8_t) (data >> 24), vword };
+   return vword | ((uint32_t) (uint8_t) ~vword << 8)
+         | ((uint32_t) crc8(b, sizeof(b)) << 16) | (REC_TAG << 24);
+}
+
+#ifndef EEPROM_SIM
+
+static void flash_unlock(void) {
+   if (FLASH->CR & FLASH_CR_LOCK) {
+      FLASH->KEYR = FLASH_KEY1;
+      FLASH->KEYR = FLASH_KEY2;
+   }
+}
+
+// wait for the operation, clear EOP and any error flags
+static uint8_t flash_wait(void) {
+   while (FLASH->SR & FLASH_SR_BSY) {
+   }
+   uint32_t err = FLASH->SR & (FLASH_SR_OPERR | FLASH_SR_PROGERR
+         | FLASH_SR_WRPERR | FLASH_SR_PGAERR | FLASH_SR_SIZERR
+         | FLASH_SR_PGSERR | FLASH_SR_MISERR | FLASH_SR_FASTERR);
+   FLASH->SR = err | FLASH_SR_EOP;
+   if (err) {
+      fee_stats.errors++;
+      return 0;
+   }
+   return 1;
+}
+
+static uint8_t program_dword(uint8_t page, uint16_t slot, uint32_t lo,
+      uint32_t hi) {
+   volatile uint32_t *dst = (volatile uint32_t *) ((page ? FEE_PAGE_B
+         : FEE_PAGE_A) + slot * 8u);
+
+   flash_unlock();
+   flash_wait();                         // clears flags left by an old op
+   FLASH->CR |= FLASH_CR_PG;
+   dst[0] = lo;
+   dst[1] = hi;                          // second word starts programming
+   uint8_t ok = flash_wait();
+   FLASH->CR &= ~FLASH_CR_PG;
+   FLASH->CR |= FLASH_CR_LOCK;
+   fee_stats.programs++;
+   return ok;
+}
+
+static uint8_t erase_page(uint8_t page) {
+   flash_unlock();
+   flash_wait();
+   FLASH->CR &= ~FLASH_CR_PNB;
+   FLASH->CR |= FLASH_CR_PER | FLASH_CR_BKER
+         | ((uint32_t) (FEE_BANK2_PAGE0 + page) << FLASH_CR_PNB_Pos);
+   FLASH->CR |= FLASH_CR_STRT;
+   uint8_t ok = flash_wait();
+   FLASH->CR &= ~(FLASH_CR_PER | FLASH_CR_BKER | FLASH_CR_PNB);
+   FLASH->CR |= FLASH_CR_LOCK;
+
+   // data cache may still hold the old contents
+   if (FLASH->ACR & FLASH_ACR_DCEN) {
+      FLASH->ACR &= ~FLASH_ACR_DCEN;
+      FLASH->ACR |= FLASH_ACR_DCRST;
+      FLASH->ACR &= ~FLASH_ACR_DCRST;
+      FLASH->ACR |= FLASH_ACR_DCEN;
+   }
+   fee_stats.erases++;
+   return ok;
+}
+
+#else /* EEPROM_SIM */
+
+static uint8_t program_dword(uint8_t page, uint16_t slot, uint32_t lo,
+      uint32_t hi) {
+   sim_flash[page][slot * 2] &= lo;      // programming only clears bits
+   sim_flash[page][slot * 2 + 1] &= hi;
+   EE_sim_advance_us(SIM_PROG_US);
+   fee_stats.programs++;
+   return 1;
+}
+
+static uint8_t erase_page(uint8_t page) {
+   memset(sim_flash[page], 0xFF, sizeof(sim_flash[page]));
+   EE_sim_advance_us(SIM_ERASE_US);
+   fee_stats.erases++;
+   return 1;
+}
+
+#endif /* EEPROM_SIM */
+
+static uint8_t page_valid(uint8_t page) {
+   return page_ptr(page)[0] == FEE_MAGIC;
+}
+
+// fresh page: header goes last so a torn format/swap is never mounted
+static uint8_t write_header(uint8_t page, uint32_t g) {
+   return program_dword(page, 0, FEE_MAGIC, g);
+}
+
+// page swap: latest value of every live word into the other page
+static uint8_t swap_pages(void) {
+   uint8_t dst = !active;
+   uint16_t slot = 1;
+
+   if (!erase_page(dst)) {
+      return 0;
+   }
+   for (uint8_t w = 0; w < FEE_VWORDS; w++) {
+      if (mirror[w] != WORD_BLANK) {
+         program_dword(dst, slot++, mirror[w], rec_hi(w, mirror[w]));
+      }
+   }
+   if (!write_header(dst, gen + 1)) {
+      return 0;
+   }
+   erase_page(active);
+   active = dst;
+   gen++;
+   next_slot = slot;
+   fee_stats.swaps++;
+   return 1;
+}
+
+void FEE_mount(void) {
+   uint8_t a = page_valid(0);
+   uint8_t b = page_valid(1);
+
+   memset(mirror, 0xFF, sizeof(mirror));
+   if (!a && !b) {                       // first use: format page A
+      erase_page(0);
+      write_header(0, 0);
+      active = 0;
+      gen = 0;
+      next_slot = 1;
+      return;
+   }
+   if (a && b) {                         // swap done but old page not erased
+      active = (int32_t) (page_ptr(1)[1] - page_ptr(0)[1]) > 0;
+   } else {
+      active = b;
+   }
+   gen = page_ptr(active)[1];
+
+   const uint32_t *p = page_ptr(active);
+   for (next_slot = 1; next_slot <= FEE_SLOTS; next_slot++) {
+      uint32_t lo = p[next_slot * 2];
+      uint32_t hi = p[next_slot * 2 + 1];
+      if (lo == WORD_BLANK && hi == WORD_BLANK) {
+         break;                          // end of the records
+      }
+      uint8_t w = hi & 0xFF;
+      if (w < FEE_VWORDS && hi == rec_hi(w, lo)) {
+         mirror[w] = lo;                 // later records win
+      }
+   }
+}
+
+void FEE_read(uint16_t vaddr, uint8_t *buf, uint16_t len) {
+   for (uint16_t i = 0; i < len && vaddr + i < FEE_VSIZE; i++) {
+      uint16_t a = vaddr + i;
+      buf[i] = (uint8_t) (mirror[a / 4] >> (8 * (a % 4)));
+   }
+}
+
+uint8_t FEE_write(uint16_t vaddr, const uint8_t *buf, uint16_t len) {
+   if (vaddr + len > FEE_VSIZE) {
+      return 0;
+   }
+   uint16_t i = 0;
+   while (i < len) {
+      uint8_t w = (vaddr + i) / 4;
+      uint32_t v = mirror[w];
+      // merge every byte of buf that falls in word w
+      for (; i < len && (vaddr + i) / 4 == w; i++) {
+         uint8_t sh = 8 * ((vaddr + i) % 4);
+         v = (v & ~(0xFFu << sh)) | ((uint32_t) buf[i] << sh);
+      }
+      if (v == mirror[w]) {
+         fee_stats.skipped++;
+         continue;
+      }
+      mirror[w] = v;                     // a swap copies the new value too
+      if (next_slot > FEE_SLOTS) {
+         if (!swap_pages()) {
+            return 0;
+         }
+         continue;
+      }
+      if (!program_dword(active, next_slot++, v, rec_hi(w, v))) {
+         return 0;
+      }
+   }
+   return 1;
+}
+
+const FEE_Stats *FEE_get_stats(void) {
+   return &fee_stats;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file flash_ee.h
+ * @brief Header EEPROM emulation in STM32L4A6 internal flash
+ *
+ *  - Small virtual byte space (FEE_VSIZE) kept as 32-bit words
+ *  - Two 2 KB pages at the end of bank 2; each update programs one
+ *    double word [data:4][vword][~vword][crc8][0xA5] at the next free slot
+ *  - Page full: live words are copied to the other page, its header
+ *    (magic + generation) is programmed last, then the old page is erased
+ *  - Reads come from a RAM mirror built at mount
+ *  - The linker script must keep the firmware out of the last 4 KB
+ *
+ * @date Dec. 18, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#ifndef SRC_FLASH_EE_H_
+#define SRC_FLASH_EE_H_
+
+#ifndef EEPROM_SIM
+#include "stm32l4xx.h"
+#endif
+#include <stdint.h>
+
+#define FEE_PAGE_SIZE   2048
+#define FEE_PAGE_A      0x080FF000u       // bank 2, page 254
+#define FEE_PAGE_B      0x080FF800u       // bank 2, page 255
+#define FEE_BANK2_PAGE0 254               // page number of FEE_PAGE_A in bank 2
+#define FEE_VSIZE       256               // virtual bytes
+#define FEE_VWORDS      (FEE_VSIZE / 4)
+#define FEE_SLOTS       (FEE_PAGE_SIZE / 8 - 1)   // records per page
+
+typedef struct {
+    uint32_t programs;       // double words programmed
+    uint32_t erases;         // page erases
+    uint32_t swaps;          // page-swap garbage collections
+    uint32_t skipped;        // written words already holding the value
+    uint32_t errors;         // program/erase ops ending with an error flag
+} FEE_Stats;
+
+/**
+ * @brief pick the newest valid page and rebuild the RAM mirror from it
+ *        (formats the pages on first use)
+ */
+void FEE_mount(void);
+
+/**
+ * @brief copy len virtual bytes at vaddr into buf
+ */
+void FEE_read(uint16_t vaddr, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief store len bytes at vaddr, only words that change are programmed
+ *
+ * @return 1 = stored, 0 = out of range or flash error
+ */
+uint8_t FEE_write(uint16_t vaddr, const uint8_t *buf, uint16_t len);
+
+const FEE_Stats *FEE_get_stats(void);
+
+#endif /* SRC_FLASH_EE_H_ */
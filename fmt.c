@@ -0,0 +1,254 @@
+/*
+------------------------------------------------------------------------------
+fmt.c
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 fmt.c
+******************************************************************************
+* @file           : fmt.c
+* @brief          : printf-like writer into a sink, no heap, no newlib
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/23/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2
+* wiring       	  : n/a
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/23/2025      :	Created file
+******************************************************************************
+*/
+
+#include "fmt.h"
+#include "uart_tx.h"
+#include "term.h"
+
+/*
+ * Conversions: %u %d %x %X %s %c %%
+ *    flags    '-' left-justify, '0' zero pad (numbers)
+ *    width    digits or '*'
+ *    .prec    %s: at most prec chars (names: %.3s)
+ *             %u/%d: fixed point, prec fraction digits (1234 %.2u = 12.34)
+ *    'l'      accepted and ignored, int is 32 bits here
+ */
+
+static const char pad_sp[] = "                ";
+static const char pad_zero[] = "0000000000000000";
+
+static void pad(FMT_Sink *sink, const char *fill, int16_t n) {
+   while (n > 0) {
+      uint16_t k = (n > 16) ? 16 : n;
+      sink->write(sink, fill, k);
+      n -= k;
+   }
+}
+
+// digits of v into the end of tmp (12 bytes), returns the first digit
+static char *utoa_rev(char *end, uint32_t v, uint8_t base, uint8_t upper) {
+   const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+   do {
+      *--end = digits[v % base];
+      v /= base;
+   } while (v);
+   return end;
+}
+
+/*
+ * Function 1: fmt_vprint
+ * --------------------
+ * walks fmt once; literal runs, digits and string arguments are each
+ *    handed to the sink as one write, nothing is assembled first
+ *
+ *	takes in: sink, fmt, ap
+ *
+ *  returns: characters produced (including any the sink cut off)
+ */
+uint16_t fmt_vprint(FMT_Sink *sink, const char *fmt, va_list ap) {
+   uint16_t total = 0;
+
+   while (*fmt) {
+      const char *lit = fmt;
+      while (*fmt && *fmt != '%')
+         fmt++;
+      if (fmt != lit) {
+         sink->write(sink, lit, fmt - lit);
+         total += fmt - lit;
+      }
+      if (!*fmt)
+         break;
+      fmt++;
+
+      uint8_t left = 0, zero = 0;
+      int16_t width = 0, prec = -1;
+      for (;; fmt++) {
+         if (*fmt == '-')
+            left = 1;
+         else if (*fmt == '0')
+            zero = 1;
+         else
+            break;
+      }
+      if (*fmt == '*') {
+         width = va_arg(ap, int);
+         fmt++;
+      }
+      while (*fmt >= '0' && *fmt <= '9')
+         width = width * 10 + (*fmt++ - '0');
+      if (*fmt == '.') {
+         fmt++;
+         prec = 0;
+         if (*fmt == '*') {
+            prec = va_arg(ap, int);
+            fmt++;
+         }
+         while (*fmt >= '0' && *fmt <= '9')
+            prec = prec * 10 + (*fmt++ - '0');
+      }
+      while (*fmt == 'l')
+         fmt++;
+
+      char tmp[16];
+      const char *s = tmp;
+      uint16_t len;
+      char sign = 0;
+      char conv = *fmt;
+      if (conv)
+         fmt++;
+
+      switch (conv) {
+      case 'c':
+         tmp[0] = (char) va_arg(ap, int);
+         len = 1;
+         break;
+      case 's':
+         s = va_arg(ap, const char*);
+         if (!s)
+            s = "(null)";
+         for (len = 0; s[len] && (prec < 0 || len < prec); len++)
+            ;
+         break;
+      case 'd':
+      case 'u':
+      case 'x':
+      case 'X': {
+         uint32_t v;
+         if (conv == 'd') {
+            int32_t d = va_arg(ap, int32_t);
+            v = (d < 0) ? 0u - (uint32_t) d : (uint32_t) d;
+            if (d < 0)
+               sign = '-';
+         } else {
+            v = va_arg(ap, uint32_t);
+         }
+         char *end = &tmp[sizeof(tmp)];
+         char *p = utoa_rev(end, v, (conv == 'x' || conv == 'X') ? 16 : 10,
+               conv == 'X');
+         if (prec > 0 && (conv == 'd' || conv == 'u') && prec < 12) {
+            // fixed point: at least one integer digit, then '.' + prec
+            while (end - p <= prec)
+               *--p = '0';
+            for (char *q = p - 1; q < end - prec - 1; q++)
+               q[0] = q[1];
+            p--;
+            end[-prec - 1] = '.';
+         }
+         s = p;
+         len = end - p;
+         break;
+      }
+      case '%':
+         tmp[0] = '%';
+         len = 1;
+         break;
+      default:                        // unknown conversion, show it as is
+         tmp[0] = '%';
+         tmp[1] = conv;
+         len = conv ? 2 : 1;
+         break;
+      }
+
+      int16_t fill = width - len - (sign != 0);
+      if (!left && !(zero && conv != 's' && conv != 'c'))
+         pad(sink, pad_sp, fill);
+      if (sign)
+         sink->write(sink, &sign, 1);
+      if (!left && zero && conv != 's' && conv != 'c')
+         pad(sink, pad_zero, fill);
+      sink->write(sink, s, len);
+      if (left)
+         pad(sink, pad_sp, fill);
+      total += len + (sign != 0) + (fill > 0 ? fill : 0);
+   }
+   return total;
+}
+
+uint16_t fmt_print(FMT_Sink *sink, const char *fmt, ...) {
+   va_list ap;
+   va_start(ap, fmt);
+   uint16_t n = fmt_vprint(sink, fmt, ap);
+   va_end(ap);
+   return n;
+}
+
+// ---------------------------------------------------------------- sinks --
+
+static void uart_write(FMT_Sink *sink, const char *s, uint16_t n) {
+   (void) sink;
+   uart_tx_write(s, n);
+}
+
+// keeps buf 0-terminated, drops what does not fit
+static void buffer_write(FMT_Sink *sink, const char *s, uint16_t n) {
+   while (n-- && sink->len + 1 < sink->cap)
+      sink->buf[sink->len++] = *s++;
+   sink->buf[sink->len] = 0;
+}
+
+static void term_write(FMT_Sink *sink, const char *s, uint16_t n) {
+   sink->col += term_putn(sink->row, sink->col, s, n);
+}
+
+void fmt_uart_sink(FMT_Sink *sink) {
+   sink->write = uart_write;
+}
+
+void fmt_buffer_sink(FMT_Sink *sink, char *buf, uint16_t cap) {
+   sink->write = buffer_write;
+   sink->buf = buf;
+   sink->len = 0;
+   sink->cap = cap;
+   if (cap)
+      buf[0] = 0;
+}
+
+void fmt_term_sink(FMT_Sink *sink, uint8_t row, uint8_t col) {
+   sink->write = term_write;
+   sink->row = row;
+   sink->col = col;
+}
+
+uint16_t uart_printf(const char *fmt, ...) {
+   FMT_Sink sink;
+   va_list ap;
+   fmt_uart_sink(&sink);
+   va_start(ap, fmt);
+   uint16_t n = fmt_vprint(&sink, fmt, ap);
+   va_end(ap);
+   return n;
+}
+
+uint16_t term_printf(uint8_t row, uint8_t col, const char *fmt, ...) {
+   FMT_Sink sink;
+   va_list ap;
+   fmt_term_sink(&sink, row, col);
+   va_start(ap, fmt);
+   uint16_t n = fmt_vprint(&sink, fmt, ap);
+   va_end(ap);
+   return n;
+}
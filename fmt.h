@@ -0,0 +1,55 @@
+/*
+------------------------------------------------------------------------------
+fmt.h
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 fmt.h
+******************************************************************************
+* @file           : fmt.h
+* @brief          : header for fmt.c (printf-like writer, no heap)
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/23/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2
+* wiring       	  : n/a
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/23/2025      :	Created file
+******************************************************************************
+*/
+
+// --------------------------------------------------- #includes for fmt.c --
+#ifndef FMT_H
+#define FMT_H
+
+#include <stdint.h>
+#include <stdarg.h>
+
+// Where formatted text goes. The writer hands each piece (literal run,
+// number digits, string argument, padding) straight to write().
+typedef struct FMT_Sink {
+   void (*write)(struct FMT_Sink *sink, const char *s, uint16_t n);
+   char *buf;                       // buffer sink (LCD line, scratch)
+   uint16_t len;
+   uint16_t cap;
+   uint8_t row;                     // term sink position, advances
+   uint8_t col;
+} FMT_Sink;
+
+// ---------- Function Prototypes --------------------------------------------
+void fmt_uart_sink(FMT_Sink *sink);
+void fmt_buffer_sink(FMT_Sink *sink, char *buf, uint16_t cap);
+void fmt_term_sink(FMT_Sink *sink, uint8_t row, uint8_t col);
+uint16_t fmt_vprint(FMT_Sink *sink, const char *fmt, va_list ap);
+uint16_t fmt_print(FMT_Sink *sink, const char *fmt, ...);
+uint16_t uart_printf(const char *fmt, ...);
+uint16_t term_printf(uint8_t row, uint8_t col, const char *fmt, ...);
+
+#endif // FMT_H
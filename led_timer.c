@@ -29,6 +29,11 @@ led_timer.c
 * 11/19/25	Removed nibble count from V1
 * 			Included delay and moved software delay
 * 11/23/25    Added array typedef structure and leveling logic
+* 12/16/25    Per-round telemetry (reaction times, outcome) to EEPROM
+* 12/26/25    LED timing in ms on software timers, no software_delay
+* 12/28/25    Game is a state machine on the event loop (evloop.c)
+* 12/29/25    Playback waits in pm_idle (Sleep / Stop 2)
+* 12/30/25    show_sequence is a profiling zone
 ******************************************************************************
 */
 
@@ -37,9 +42,25 @@ led_timer.c
 #include "delay.h"
 #include "nvic.h"
 #include "main.h"
+#include "telemetry.h"
+#include "swtimer.h"
+#include "evloop.h"
+#include "lowpower.h"
+#include "prof.h"
 
 volatile uint32_t sw_delay_ms = 3000;
 
+// color code 1..5 -> PC8..PC12
+static const uint16_t led_pin[6] = {
+   0, GPIO_PIN_8, GPIO_PIN_9, GPIO_PIN_10, GPIO_PIN_11, GPIO_PIN_12
+};
+
+// sequence playback, stepped by a periodic software timer
+static SWT_Timer play_timer;
+static const Sequence *play_seq;
+static volatile uint32_t play_step;   // even = LED on, odd = LED off
+static volatile uint8_t play_busy;
+
 /*
  * Function 1:  led_init
  * --------------------
@@ -129,65 +150,21 @@ uint32_t flash_rnd_led(void) {
 /*
  * Function 2:  show_led
  * --------------------
- * actually flashes the led
+ * actually flashes the led: LED_ON_MS on, LED_OFF_MS off, sleeping on
+ *    the software timer in between
  *
  *	takes in: uint32_t color code
  *
  *  returns: nothing
  */
 void show_led(uint32_t color) {
-   switch (color) {
-      case 1:
-	    // Turn on all LEDS
-		GPIOC->BSRR = GPIO_PIN_8;
-		// Call a visible delay
-		software_delay(1500);
-		// Ensure all LEDS are off
-		GPIOC->BRR = LED_MASK;
-		// Call a visible delay
-		software_delay(1500);
-		break;
-      case 2:
-		 // Turn on all LEDS
-		 GPIOC->BSRR = GPIO_PIN_9;
-		 // Call a visible delay
-		 software_delay(1500);
-		 // Ensure all LEDS are off
-		 GPIOC->BRR = LED_MASK;
-		 // Call a visible delay
-		 software_delay(1500);
-   		 break;
-	  case 3:
-		 // Turn on all LEDS
-		 GPIOC->BSRR = GPIO_PIN_10;
-		 // Call a visible delay
-		 software_delay(1500);
-		 // Ensure all LEDS are off
-		 GPIOC->BRR = LED_MASK;
-		 // Call a visible delay
-		 software_delay(1500);
-		 break;
-	  case 4:
-		 // Turn on all LEDS
-		 GPIOC->BSRR = GPIO_PIN_11;
-		 // Call a visible delay
-		 software_delay(1500);
-		 // Ensure all LEDS are off
-		 GPIOC->BRR = LED_MASK;
-		 // Call a visible delay
-		 software_delay(1500);
-		 break;
-	  case 5:
-		 // Turn on all LEDS
-		 GPIOC->BSRR = GPIO_PIN_12;
-		 // Call a visible delay
-		 software_delay(1500);
-		 // Ensure all LEDS are off
-         GPIOC->BRR = LED_MASK;
-		 // Call a visible delay
-		 software_delay(1500);
-		 break;
-	}
+   if (color < 1 || color > 5)
+      return;
+   GPIOC->BSRR = led_pin[color];
+   swt_wait_ms(LED_ON_MS);
+   // Ensure all LEDS are off
+   GPIOC->BRR = LED_MASK;
+   swt_wait_ms(LED_OFF_MS);
 }
 
 /*
@@ -245,6 +222,36 @@ void generate_led_sequence(Sequence *seq) {
    Sequence_Append(seq, next);
 }
 
+// one playback step per expiry (TIM2 interrupt): LED on, then off
+static void play_tick(void *arg) {
+   uint32_t i = play_step / 2;
+   if (i >= play_seq->length) {
+      play_busy = 0;
+      ev_post(EV_PLAYBACK_DONE, 0);
+      return;
+   }
+   if ((play_step & 1) == 0) {
+      GPIOC->BSRR = led_pin[play_seq->data[i] <= 5 ? play_seq->data[i] : 0];
+      swt_start_ms(&play_timer, LED_ON_MS, 0, play_tick, 0);
+   } else {
+      GPIOC->BRR = LED_MASK;
+      swt_start_ms(&play_timer, LED_OFF_MS, 0, play_tick, 0);
+   }
+   play_step++;
+}
+
+// starts playback and returns; the timer interrupt steps through it
+void show_sequence_start(const Sequence *seq) {
+   play_seq = seq;
+   play_step = 0;
+   play_busy = 1;
+   swt_start_ms(&play_timer, 0, LED_ON_MS, play_tick, 0);
+}
+
+uint8_t show_sequence_busy(void) {
+   return play_busy;
+}
+
 /*
  * Function 6: show_sequence
  * --------------------
@@ -258,92 +265,151 @@ void generate_led_sequence(Sequence *seq) {
  *  returns: nothing
  */
 void show_sequence(const Sequence *seq) {
-   for (uint32_t i = 0; i < seq->length; i++) {
-      show_led(seq->data[i]);   // turn on corresponding LED
-//        software_delay(sw_delay_ms);           // visible time
-      GPIOC->BRR = LED_MASK;
-//        software_delay(sw_delay_ms);
+   PROF_BEGIN(PROF_SHOW_SEQ);
+   show_sequence_start(seq);
+   __disable_irq();
+   while (play_busy) {
+      pm_idle();                      // Stop 2 between LED steps
+      __enable_irq();
+      __disable_irq();
    }
+   __enable_irq();
+   PROF_END(PROF_SHOW_SEQ);
 }
 
 /*
- * Function 7: run_reaction_game
+ * Function 7: game_start
  * --------------------
- * runs reaction game starting with a sequence, level @ 1, and user seq
- *    hops into infinite while loop, generates the values for sequence,
- *    flashes sequence, awaits user input, and compares user seq with
- *    sequence
- *
- *    interrupt 1 = wrong, gave up
- *    interrupt 2 = passed!
+ * event-driven reaction game: each level generates a sequence, plays it
+ *    on the LEDs (EV_PLAYBACK_DONE), pauses, then collects EV_BUTTON
+ *    presses until the sequence is complete, wrong, or the answer window
+ *    timer runs out; game_running() goes to 0 when the game is over.
+ *    Needs game_init() once so the handlers are registered.
  *
  *	takes in: nothing
  *
  *  returns: nothing
  */
-void run_reaction_game(void) {
+typedef enum {
+    GAME_IDLE = 0,
+    GAME_SHOW,                                // LEDs playing the sequence
+    GAME_PAUSE,                               // SEQ_PAUSE_MS before input
+    GAME_INPUT                                // waiting on button presses
+} GameState;
+
+static struct {
+    GameState state;
+    uint32_t level;
     Sequence seq;
-    uint32_t level = 1;
+    Sequence user_seq;
+    TLM_Round round;                          // telemetry for this level
+    uint32_t t_prev_us;                       // reaction times to the us
+    EV_Timer timer;                           // pause, then answer window
+} game;
 
-    while (1) {
-        if (level > MAX_SEQ_LEN) {
-            // Player won
-            // trigger_interrupt(2);
-            return;
-        }
+static void game_end(void) {
+    game.state = GAME_IDLE;
+    ev_timer_stop(&game.timer);
+}
 
-        // 1) Generate a fresh sequence of length = level
-        Sequence_Init(&seq);
-        for (uint32_t lvl_idx = 0; lvl_idx < level; lvl_idx++) {
-            uint8_t next = flash_rnd_led();   // returns color code only
-            Sequence_Append(&seq, next);
-        }
+static void game_next_level(void) {
+    if (game.level > MAX_SEQ_LEN) {
+        // Player won
+        game_end();
+        return;
+    }
 
-        // 2) Show the whole sequence
-        show_sequence(&seq);
-        software_delay(3000);
+    // 1) Generate a fresh sequence of length = level
+    Sequence_Init(&game.seq);
+    for (uint32_t lvl_idx = 0; lvl_idx < game.level; lvl_idx++) {
+        uint8_t next = flash_rnd_led();       // returns color code only
+        Sequence_Append(&game.seq, next);
+    }
 
-        // 3) Get user input
-        const uint32_t ANSWER_WINDOW_MS = 30000U; // 30 seconds to answer
-        uint32_t t_start  = get_ms();
-        uint32_t deadline = t_start + ANSWER_WINDOW_MS;
+    // 2) Show the whole sequence, EV_PLAYBACK_DONE when finished
+    game.state = GAME_SHOW;
+    show_sequence_start(&game.seq);
+}
 
-        Sequence user_seq;
-        Sequence_Init(&user_seq);
+static void game_answer_timeout(void *arg) {
+    // Timeout
+    TLM_round_end(&game.round, TLM_TIMEOUT);
+    TLM_log_round(&game.round);
+    game_end();
+}
+
+// 3) Get user input: answer window opens after the pause
+static void game_open_input(void *arg) {
+    game.state = GAME_INPUT;
+    Sequence_Init(&game.user_seq);
+    TLM_round_begin(&game.round, (uint8_t)game.level);
+    game.t_prev_us = get_us();
+    ev_timer_start(&game.timer, ANSWER_WINDOW_MS, 0, game_answer_timeout, 0);
+}
 
-        // Collect exactly seq.length button presses (or timeout)
-        for (uint32_t seq_idx = 0; seq_idx < seq.length; seq_idx++) {
-            uint32_t input_color;
+static void game_on_playback(const EV_Event *ev) {
+    if (game.state != GAME_SHOW)
+        return;
+    game.state = GAME_PAUSE;
+    ev_timer_start(&game.timer, SEQ_PAUSE_MS, 0, game_open_input, 0);
+}
 
-            // Wait for a button press until deadline
-            if (!read_user_color_until(deadline, &input_color)) {
-                // Timeout
-                // trigger_interrupt(1);
-                return;
-            }
+static void game_on_button(const EV_Event *ev) {
+    if (game.state != GAME_INPUT)
+        return;                               // presses during playback
 
-            Sequence_Append(&user_seq, (uint8_t)input_color);
-        }
+    // press time was stamped in the EXTI handler
+    TLM_round_press(&game.round, (ev->t_us - game.t_prev_us + 500) / 1000);
+    game.t_prev_us = ev->t_us;
+    Sequence_Append(&game.user_seq, (uint8_t)ev->arg);
+    if (game.user_seq.length < game.seq.length)
+        return;
 
-        // 4) Compare sequences
-        bool correct = true;
-        for (uint32_t seq_idx = 0; seq_idx < seq.length; seq_idx++) {
-            if (user_seq.data[seq_idx] != seq.data[seq_idx]) {
-                correct = false;
-                break;
-            }
+    // 4) Compare sequences
+    ev_timer_stop(&game.timer);
+    bool correct = true;
+    for (uint32_t seq_idx = 0; seq_idx < game.seq.length; seq_idx++) {
+        if (game.user_seq.data[seq_idx] != game.seq.data[seq_idx]) {
+            correct = false;
+            break;
         }
+    }
 
-        if (!correct) {
-            // Wrong answer
-            // trigger_interrupt(1);
-            return;
-        }
+    TLM_round_end(&game.round, correct ? TLM_PASS : TLM_WRONG);
+    TLM_log_round(&game.round);
 
-        // If we get here, the whole sequence was correct
-        // trigger_interrupt(2);
-        level++;
+    if (!correct) {
+        // Wrong answer
+        game_end();
+        return;
     }
+
+    // If we get here, the whole sequence was correct
+    game.level++;
+    game_next_level();
+}
+
+void game_init(void) {
+    ev_on(EV_PLAYBACK_DONE, game_on_playback);
+    ev_on(EV_BUTTON, game_on_button);
+}
+
+void game_start(void) {
+    TLM_session_begin();                      // profile's reaction mean
+    game.level = 1;
+    game_next_level();
+}
+
+uint8_t game_running(void) {
+    return game.state != GAME_IDLE;
+}
+
+// blocking form for callers outside the loop: runs the event loop until
+// the game is over
+void run_reaction_game(void) {
+    game_start();
+    while (game_running())
+        ev_run_once();
 }
 
 /*
@@ -360,12 +426,12 @@ void flash_led(void) {
 	GPIOC->BSRR = LED_MASK;
 
 	// Call a visible delay
-	software_delay(3000);
+	swt_wait_ms(FLASH_MS);
 
 	// Ensure all LEDS are off
 	GPIOC->BRR = LED_MASK;
 
 	// Call a visible delay
-	software_delay(3000);
+	swt_wait_ms(FLASH_MS);
 }
 
@@ -29,6 +29,8 @@ led_timer.h
 * 11/19/25	Removed nibble count from V1
 * 			Included delay and moved software delay
 * 11/23/25    Added array typedef structure and leveling logic
+* 12/26/25    LED timing constants in ms, non-blocking sequence playback
+* 12/28/25    Event-driven game (game_init/game_start)
 ******************************************************************************
 */
 
@@ -46,6 +48,13 @@ led_timer.h
 #define LED_MASK (GPIO_PIN_8 | GPIO_PIN_9 | GPIO_PIN_10 | GPIO_PIN_11 | GPIO_PIN_12);
 
 #define MAX_SEQ_LEN 32
+
+// LED timing in real time (software_delay(1500) was ~375 ms at 4 MHz)
+#define LED_ON_MS     375   // one sequence step lit
+#define LED_OFF_MS    375   // gap before the next step
+#define SEQ_PAUSE_MS  750   // after playback, before input opens
+#define FLASH_MS      750   // flash_led on and off time
+#define ANSWER_WINDOW_MS 30000U  // 30 seconds to answer a level
 extern volatile uint32_t sw_delay_ms;
 
 // ---------- Custom Array Structure -----------------------------------------
@@ -63,6 +72,11 @@ void Sequence_Init(Sequence *seq); // initialize sequence variable type
 uint8_t Sequence_Append(Sequence *seq, uint8_t value);
 void generate_led_sequence(Sequence *seq);
 void show_sequence(const Sequence *seq);
+void show_sequence_start(const Sequence *seq);
+uint8_t show_sequence_busy(void);
+void game_init(void);
+void game_start(void);
+uint8_t game_running(void);
 void run_reaction_game(void);
 
 #endif // LED_TIMER_H
@@ -0,0 +1,210 @@
+/*
+------------------------------------------------------------------------------
+lowpower.c
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 lowpower.c
+******************************************************************************
+* @file           : lowpower.c
+* @brief          : tickless idle: Sleep or Stop 2 until the next software
+*                   timer deadline or wake-up interrupt
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/29/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2, LSE (LSI fallback) to LPTIM1
+* wiring       	  : n/a
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/29/2025      :	Created file
+******************************************************************************
+*/
+
+#include "lowpower.h"
+#include "delay.h"
+#include "swtimer.h"
+#include "uart_tx.h"
+#include "eeprom_async.h"
+
+#define LPTIM_MAX     0xFFFFu        // ARR, ~2 s of LSE ticks per Stop 2
+#define LSE_HZ        32768u
+#define LSI_HZ        32000u
+
+// Every deadline lives on the TIM2 software timers (the event loop arms
+// one for its wheel), so the next one is swt_next_due(). TIM2 stops in
+// Stop 2: LPTIM1 on the 32 kHz clock wakes the part just before that
+// deadline and measures the time asleep, which is added back to TIM2.
+static uint32_t lptim_hz = LSI_HZ;
+static uint8_t pm_ready;                        // LPTIM1 set up
+static uint64_t t_init;
+static PM_Stats pm_stats;
+
+// LSE is more accurate for the compensation but can take a second or
+// two to start, so LPTIM1 runs on LSI until LSERDY shows up
+static void pick_clock(void) {
+   if (lptim_hz == LSE_HZ || !(RCC->BDCR & RCC_BDCR_LSERDY))
+      return;
+   RCC->CCIPR |= RCC_CCIPR_LPTIM1SEL;           // 11 = LSE
+   lptim_hz = LSE_HZ;
+}
+
+/*
+ * Function 1: pm_init
+ * --------------------
+ * starts LSE (and LSI meanwhile), clocks LPTIM1 from it, routes its
+ *    compare match (EXTI 32) and the LPUART1 wake-up (EXTI 31) so they
+ *    end Stop 2. Button EXTI lines 3..13 wake it already.
+ *    Call after timebase_init() and UART_setup().
+ *
+ *	takes in: nothing
+ *
+ *  returns: nothing
+ */
+void pm_init(void) {
+   RCC->APB1ENR1 |= RCC_APB1ENR1_PWREN | RCC_APB1ENR1_LPTIM1EN;
+   PWR->CR1 |= PWR_CR1_DBP;                     // BDCR is write protected
+   RCC->BDCR |= RCC_BDCR_LSEON;                 // no wait, see pick_clock
+   RCC->CSR |= RCC_CSR_LSION;
+   while (!(RCC->CSR & RCC_CSR_LSIRDY))
+      ;
+   RCC->CCIPR = (RCC->CCIPR & ~RCC_CCIPR_LPTIM1SEL)
+         | RCC_CCIPR_LPTIM1SEL_0;               // 01 = LSI
+   pick_clock();
+
+   LPTIM1->CR = 0;
+   LPTIM1->CFGR = 0;                            // internal clock, no prescale
+   LPTIM1->IER = LPTIM_IER_CMPMIE;              // writable while disabled
+   EXTI->IMR2 |= EXTI_IMR2_IM32;                // LPTIM1 wakes Stop 2
+   EXTI->IMR1 |= EXTI_IMR1_IM31;                // LPUART1 wakes Stop 2
+   NVIC_SetPriority(LPTIM1_IRQn, 0);
+   NVIC_EnableIRQ(LPTIM1_IRQn);
+
+   PWR->CR1 = (PWR->CR1 & ~PWR_CR1_LPMS) | PWR_CR1_LPMS_STOP2;
+#ifdef DEBUG
+   DBGMCU->CR |= DBGMCU_CR_DBG_STOP;            // keep SWD alive in Stop
+#endif
+   t_init = get_us64();
+   pm_ready = 1;
+}
+
+// the wake-up already happened, only the flag is left
+void LPTIM1_IRQHandler(void) {
+   LPTIM1->ICR = LPTIM_ICR_CMPMCF;
+}
+
+// DMA and the I2C engine have no clock in Stop 2
+static uint8_t stop_allowed(void) {
+   return uart_tx_idle() && !EEPROM_async_pending()
+         && !(LPUART1->ISR & USART_ISR_BUSY);
+}
+
+// LPTIM1 counts asynchronously, two equal reads are a good one
+static uint32_t lptim_count(void) {
+   uint32_t a, b = LPTIM1->CNT;
+   do {
+      a = b;
+      b = LPTIM1->CNT;
+   } while (a != b);
+   return a;
+}
+
+static void enter_sleep(void) {
+   uint32_t t0 = get_us();
+   __WFI();
+   pm_stats.us[PM_SLEEP] += get_us() - t0;
+   pm_stats.sleeps++;
+}
+
+// Stop 2 for at most wait_us, TIM2 is brought forward by the time asleep
+static void enter_stop2(uint32_t wait_us) {
+   pick_clock();
+   uint32_t ticks = (uint32_t) ((uint64_t) (wait_us - PM_WAKE_US) * lptim_hz
+         / 1000000u);
+   if (ticks >= LPTIM_MAX)
+      ticks = LPTIM_MAX - 1;                    // CMP must stay below ARR
+
+   LPTIM1->CR = LPTIM_CR_ENABLE;                // counter starts from 0
+   LPTIM1->ICR = LPTIM_ICR_CMPOKCF | LPTIM_ICR_ARROKCF | LPTIM_ICR_CMPMCF;
+   LPTIM1->ARR = LPTIM_MAX;
+   while (!(LPTIM1->ISR & LPTIM_ISR_ARROK))
+      ;
+   LPTIM1->CMP = ticks;
+   while (!(LPTIM1->ISR & LPTIM_ISR_CMPOK))
+      ;
+   uint32_t t0 = get_us();
+   LPTIM1->CR |= LPTIM_CR_CNTSTRT;
+
+   SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+   __DSB();
+   __WFI();                                     // PRIMASK set: wakes, no ISR
+   SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+
+   uint32_t slept = lptim_count();
+   uint32_t ran = get_us() - t0;                // TIM2 ran this much of it
+   LPTIM1->CR = 0;
+   if (slept >= ticks)
+      pm_stats.timer_wakes++;
+   slept = (uint32_t) ((uint64_t) slept * 1000000u / lptim_hz);
+   if (slept > ran) {
+      timebase_advance(slept - ran);
+      swt_resync();
+   }
+   pm_stats.us[PM_STOP2] += (slept > ran) ? slept : ran;
+   pm_stats.stops++;
+}
+
+/*
+ * Function 2: pm_idle
+ * --------------------
+ * sleeps until an interrupt or the next software timer deadline:
+ *    Stop 2 when that is at least PM_STOP_MIN_US away and no DMA or
+ *    I2C transfer is running, Sleep (WFI) otherwise. Call with
+ *    interrupts masked after checking the wake condition, the pending
+ *    interrupt runs once the caller unmasks, with the timebase already
+ *    compensated (button press stamps stay exact).
+ *
+ *	takes in: nothing
+ *
+ *  returns: nothing
+ */
+void pm_idle(void) {
+   uint32_t due;
+   uint32_t wait = 0xFFFFFFFFu;                 // no timer: LPTIM max
+
+   if (swt_next_due(&due)) {
+      int32_t d = (int32_t) (due - get_us());
+      wait = (d > 0) ? (uint32_t) d : 0;
+   }
+   if (wait < PM_STOP_MIN_US || !pm_ready) {
+      enter_sleep();
+      return;
+   }
+   if (!stop_allowed()) {
+      pm_stats.vetoed++;
+      enter_sleep();
+      return;
+   }
+   enter_stop2(wait);
+}
+
+// per mille of the time since pm_init spent in mode
+uint16_t pm_residency(PM_Mode mode) {
+   const PM_Stats *s = pm_get_stats();
+   uint64_t total = s->us[PM_RUN] + s->us[PM_SLEEP] + s->us[PM_STOP2];
+   if (!total)
+      return 0;
+   return (uint16_t) (s->us[mode] * 1000u / total);
+}
+
+const PM_Stats *pm_get_stats(void) {
+   uint64_t total = get_us64() - t_init;
+   uint64_t idle = pm_stats.us[PM_SLEEP] + pm_stats.us[PM_STOP2];
+   pm_stats.us[PM_RUN] = (total > idle) ? total - idle : 0;
+   return &pm_stats;
+}
@@ -0,0 +1,60 @@
+/*
+------------------------------------------------------------------------------
+lowpower.h
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 lowpower.h
+******************************************************************************
+* @file           : lowpower.h
+* @brief          : header for lowpower.c (tickless idle, Sleep / Stop 2)
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/29/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2, LSE (LSI fallback) to LPTIM1
+* wiring       	  : n/a
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/29/2025      :	Created file
+******************************************************************************
+*/
+
+// --------------------------------------------- #includes for lowpower.c --
+#ifndef LOWPOWER_H
+#define LOWPOWER_H
+
+#include "stm32l4xx_hal.h"
+#include <stdint.h>
+
+#define PM_STOP_MIN_US  3000u       // shorter idles stay in Sleep
+#define PM_WAKE_US      250u        // Stop 2 exit + MSI restart, wake early
+
+typedef enum {
+   PM_RUN = 0,
+   PM_SLEEP,                        // WFI, clocks running
+   PM_STOP2,                        // deep sleep, LPTIM1 + EXTI wake
+   PM_MODE_COUNT
+} PM_Mode;
+
+typedef struct {
+   uint64_t us[PM_MODE_COUNT];      // time spent in each mode
+   uint32_t sleeps;                 // Sleep entries
+   uint32_t stops;                  // Stop 2 entries
+   uint32_t timer_wakes;            // Stop 2 ended by the LPTIM1 deadline
+   uint32_t vetoed;                 // long idles kept in Sleep (DMA, I2C)
+} PM_Stats;
+
+// ---------- Function Prototypes --------------------------------------------
+void pm_init(void);
+void pm_idle(void);
+uint16_t pm_residency(PM_Mode mode);
+const PM_Stats *pm_get_stats(void);
+void LPTIM1_IRQHandler(void);
+
+#endif // LOWPOWER_H
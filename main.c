@@ -22,6 +22,12 @@
 #include "delay.h"
 #include "EEPROM.h"
 #include "uart.h"
+#include "rank_store.h"
+#include "telemetry.h"
+#include "persist.h"
+#include "evloop.h"
+#include "lowpower.h"
+#include "prof.h"
 
 Player leaderboard[MAX_PLAYERS];
 
@@ -64,7 +70,22 @@ void SystemClock_Config(void);
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
+// event loop idle work: persist queued scores, only overdue ones while
+// a game is running so playback and reaction timing are not disturbed
+static uint8_t idle_persist(void)
+{
+  if (game_running()) {
+    PS_service(0);                  // nothing to do until overdue, sleep
+    return 0;
+  }
+  return PS_service(1);
+}
 
+// an async cache flush finished, start on the next queued update
+static void on_eeprom_done(const EV_Event *ev)
+{
+  PS_service(!game_running());
+}
 /* USER CODE END 0 */
 
 /**
@@ -91,11 +112,27 @@ int main(void)
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
+  timebase_init();                  // get_ms()/get_us() before anything waits
+#ifdef PROF_ENABLE
+  prof_init();
+#endif
+  ev_init();
+  ev_set_idle(idle_persist);
+  ev_on(EV_EEPROM_DONE, on_eeprom_done);
+  game_init();
+  uart_keys_init();
   led_init();
   rng_init();
   UART_setup();
+  pm_init();                        // Stop 2 idle from here on
   EEPROM_init();
   uint8_t leaderboardCount = loadLeaderboard(leaderboard);
+  RS_mount();
+  TLM_mount();
+  if (RS_count() == 0) {            // first boot with the rank store
+    for (uint8_t i = 0; i < leaderboardCount; i++)
+      RS_insert(leaderboard[i].name, leaderboard[i].score);
+  }
   /* USER CODE END SysInit */
 
   /* Initialize all configured peripherals */
@@ -0,0 +1,127 @@
+/**
+ * @file persist.c
+ * @brief deferred persistence of score updates
+ *
+ *  - Ring of pending rank store inserts + profile updates, each stamped
+ *    with get_ms()
+ *  - An update counts as saved once it is in the rank store, the flash
+ *    image is current and no cache page is dirty or in flight;
+ *    pending_since tracks the oldest unsaved one
+ *
+ * @date Dec. 13, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#include "persist.h"
+#include "EEPROM.h"
+#include "eeprom_async.h"
+#include "eeprom_cache.h"
+#include "rank_store.h"
+#include "profile.h"
+#include "telemetry.h"
+#include "delay.h"
+#include <string.h>
+
+typedef struct {
+    char name[NAME_LEN];
+    uint16_t score;
+    uint16_t mean_ms;                    // game's reaction mean, for the profile
+    uint16_t presses;
+    uint32_t t_queued;
+} PendingScore;
+
+static PendingScore queue[PS_QUEUE_LEN];
+static uint8_t q_head;
+static uint8_t q_count;
+static uint8_t holding;                  // something unsaved since pending_since
+static uint32_t pending_since;
+static PS_Stats ps_stats;
+
+// write the oldest queued score to the rank store
+static void drain_one(void) {
+   PendingScore *p = &queue[q_head];
+   uint32_t t_start = get_ms();
+
+   RS_insert(p->name, p->score);
+   PF_record_game(p->name, p->score, p->mean_ms, p->presses);
+   q_head = (q_head + 1) % PS_QUEUE_LEN;
+   q_count--;
+
+   uint32_t now = get_ms();
+   ps_stats.drained++;
+   ps_stats.depth = q_count;
+   ps_stats.last_step_ms = now - t_start;
+   if (ps_stats.last_step_ms > ps_stats.max_step_ms) {
+      ps_stats.max_step_ms = ps_stats.last_step_ms;
+   }
+   ps_stats.last_age_ms = now - p->t_queued;
+   if (ps_stats.last_age_ms > ps_stats.max_age_ms) {
+      ps_stats.max_age_ms = ps_stats.last_age_ms;
+   }
+}
+
+void PS_queue_score(const char *name, uint16_t score) {
+   if (q_count == PS_QUEUE_LEN) {
+      ps_stats.forced++;
+      drain_one();
+   }
+   PendingScore *p = &queue[(q_head + q_count) % PS_QUEUE_LEN];
+   memcpy(p->name, name, NAME_LEN);
+   p->score = score;
+   p->mean_ms = TLM_session_mean_ms(&p->presses);
+   p->t_queued = get_ms();
+   q_count++;
+
+   if (!holding) {
+      holding = 1;
+      pending_since = p->t_queued;
+   }
+   ps_stats.queued++;
+   ps_stats.depth = q_count;
+   if (q_count > ps_stats.max_depth) {
+      ps_stats.max_depth = q_count;
+   }
+}
+
+uint8_t PS_pending(void) {
+   if (holding && !q_count && !flashImageStale() && !EE_cache_dirty_pages()
+         && !EEPROM_async_pending()) {
+      holding = 0;                       // last flush has landed
+   }
+   return holding;
+}
+
+uint8_t PS_service(uint8_t idle) {
+   EEPROM_async_service();               // ends a transfer stuck on the bus
+   if (!PS_pending()) {
+      return 0;
+   }
+   if (!idle) {
+      if ((int32_t) (get_ms() - pending_since) < PS_DEADLINE_MS) {
+         return q_count;
+      }
+      if (q_count || EE_cache_dirty_pages()) {
+         ps_stats.forced++;
+      }
+   }
+   if (q_count) {
+      drain_one();
+   } else {
+      syncFlashImage();                  // after the queue, one step each
+   }
+   EE_cache_flush_async();
+   return q_count;
+}
+
+void PS_drain(void) {
+   while (q_count) {
+      drain_one();
+   }
+   syncFlashImage();
+   EE_cache_flush();
+   holding = 0;
+}
+
+const PS_Stats *PS_get_stats(void) {
+   return &ps_stats;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file persist.h
+ * @brief Header deferred persistence of score updates
+ *
+ *  - Game-over only touches RAM: the top-10 board and its journal slots
+ *    (cached) update at once, the rank store insert and the player's
+ *    profile update are queued here
+ *  - PS_service() drains one update per call while the game is idle
+ *    (attract screen, between rounds), then writes the stale internal
+ *    flash image, and pushes dirty cache pages out
+ *  - Outside idle time it only drains once the oldest unsaved update is
+ *    PS_DEADLINE_MS old, which bounds what a power cut can lose
+ *
+ * @date Dec. 13, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#ifndef SRC_PERSIST_H_
+#define SRC_PERSIST_H_
+
+#ifndef EEPROM_SIM
+#include "stm32l4xx.h"
+#endif
+#include <stdint.h>
+
+#define PS_QUEUE_LEN     8
+#define PS_DEADLINE_MS   5000        // max age of an update held in RAM
+
+typedef struct {
+    uint32_t queued;         // updates accepted
+    uint32_t drained;        // updates written to rank store + profile
+    uint32_t forced;         // drains run by the deadline or a full queue
+    uint8_t depth;           // updates waiting now
+    uint8_t max_depth;       // deepest the queue has been
+    uint32_t last_step_ms;   // time spent in the last drain step
+    uint32_t max_step_ms;
+    uint32_t last_age_ms;    // game-over to on-EEPROM for the last update
+    uint32_t max_age_ms;
+} PS_Stats;
+
+/**
+ * @brief queue a score for the rank store and the player's profile (with
+ *        the game's reaction mean from telemetry), returns right away
+ *        (a full queue drains its oldest entry first)
+ */
+void PS_queue_score(const char *name, uint16_t score);
+
+/**
+ * @brief one drain step: one queued update (or the stale flash image),
+ *        then an async cache flush
+ *
+ * @param idle  1 = caller is idling, 0 = only act past the deadline
+ * @return updates still queued
+ */
+uint8_t PS_service(uint8_t idle);
+
+/**
+ * @brief write everything queued and flush the cache (blocking)
+ */
+void PS_drain(void);
+
+/**
+ * @brief 1 while any update is held only in RAM
+ */
+uint8_t PS_pending(void);
+
+const PS_Stats *PS_get_stats(void);
+
+#endif /* SRC_PERSIST_H_ */
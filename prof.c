@@ -0,0 +1,134 @@
+/*
+------------------------------------------------------------------------------
+prof.c
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 prof.c
+******************************************************************************
+* @file           : prof.c
+* @brief          : DWT cycle-count profiling zones: min/max/mean and a
+*                   log2 histogram per zone, dumped over LPUART1
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/30/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2
+* wiring       	  : n/a
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/30/2025      :	Created file
+******************************************************************************
+*/
+
+#include "prof.h"
+
+#if defined(PROF_ENABLE) && !defined(EEPROM_SIM)
+
+#include "fmt.h"
+
+static PROF_Stats zones[PROF_ZONE_COUNT];
+static uint32_t overhead;            // cycles of an empty BEGIN/END pair
+
+static const char *const zone_name[PROF_ZONE_COUNT] = {
+   [PROF_EEPROM_READ]  = "EEPROM_read",
+   [PROF_EEPROM_WRITE] = "EEPROM_write",
+   [PROF_UART_PRINT]   = "LPUART_Print_string",
+   [PROF_SHOW_SEQ]     = "show_sequence",
+   [PROF_EXTI]         = "EXTI handlers",
+   [PROF_RNG]          = "rng",
+};
+
+/*
+ * Function 1: prof_init
+ * --------------------
+ * enables the DWT cycle counter and measures the cost of an empty
+ *    zone, which prof_record takes off every sample
+ *
+ *	takes in: nothing
+ *
+ *  returns: nothing
+ */
+void prof_init(void) {
+   CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+   DWT->CYCCNT = 0;
+   DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+   uint32_t t0 = DWT->CYCCNT;
+   uint32_t t1 = DWT->CYCCNT;
+   overhead = t1 - t0;
+   prof_reset();
+}
+
+/*
+ * Function 2: prof_record
+ * --------------------
+ * adds one sample to a zone; called by PROF_END, also from interrupts
+ *
+ *	takes in: zone, cycles
+ *
+ *  returns: nothing
+ */
+void prof_record(PROF_Zone zone, uint32_t cycles) {
+   PROF_Stats *z = &zones[zone];
+   cycles = (cycles > overhead) ? cycles - overhead : 0;
+   uint8_t bin = cycles ? 31 - __CLZ(cycles) : 0;
+
+   uint32_t primask = __get_PRIMASK();
+   __disable_irq();
+   z->count++;
+   z->total += cycles;
+   if (cycles < z->min)
+      z->min = cycles;
+   if (cycles > z->max)
+      z->max = cycles;
+   z->hist[bin]++;
+   __set_PRIMASK(primask);
+}
+
+void prof_reset(void) {
+   uint32_t primask = __get_PRIMASK();
+   __disable_irq();
+   for (uint8_t i = 0; i < PROF_ZONE_COUNT; i++) {
+      zones[i] = (PROF_Stats) { 0 };
+      zones[i].min = 0xFFFFFFFFu;
+   }
+   __set_PRIMASK(primask);
+}
+
+const PROF_Stats *prof_get(PROF_Zone zone) {
+   return &zones[zone];
+}
+
+/*
+ * Function 3: prof_dump
+ * --------------------
+ * prints every zone that has samples: count, min/mean/max cycles and
+ *    the non-empty histogram bins as "lower bound: count"
+ *
+ *	takes in: nothing
+ *
+ *  returns: nothing
+ */
+void prof_dump(void) {
+   uart_printf("zone                 count      min     mean      max"
+         "  (cycles @ %u Hz)\r\n", SystemCoreClock);
+   for (uint8_t i = 0; i < PROF_ZONE_COUNT; i++) {
+      PROF_Stats z = zones[i];       // copy, interrupts keep recording
+      if (!z.count)
+         continue;
+      uart_printf("%-20s %6u %8u %8u %8u\r\n", zone_name[i], z.count,
+            z.min, (uint32_t) (z.total / z.count), z.max);
+      for (uint8_t b = 0; b < PROF_HIST_BINS; b++) {
+         if (z.hist[b])
+            uart_printf("   >= %10u: %u\r\n", b ? 1u << b : 0u, z.hist[b]);
+      }
+   }
+}
+
+#endif // PROF_ENABLE
@@ -0,0 +1,80 @@
+/*
+------------------------------------------------------------------------------
+prof.h
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 prof.h
+******************************************************************************
+* @file           : prof.h
+* @brief          : header for prof.c (DWT cycle-count profiling zones)
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/30/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2
+* wiring       	  : n/a
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/30/2025      :	Created file
+******************************************************************************
+*/
+
+// ------------------------------------------------- #includes for prof.c --
+#ifndef PROF_H
+#define PROF_H
+
+#include <stdint.h>
+
+// Build with -DPROF_ENABLE to profile. Without it the macros expand to
+// nothing and prof.c is empty, so instrumented code is unchanged.
+// PROF_BEGIN/PROF_END must be in the same block: BEGIN declares the
+// start count. Cycles are core clocks, so time in Sleep/Stop 2 is not
+// counted (a zone that waits shows its CPU cost, not its length).
+#if defined(PROF_ENABLE) && !defined(EEPROM_SIM)
+
+#include "stm32l4xx_hal.h"
+
+#define PROF_HIST_BINS  32          // bin k: 2^k <= cycles < 2^(k+1)
+
+typedef enum {
+   PROF_EEPROM_READ = 0,
+   PROF_EEPROM_WRITE,
+   PROF_UART_PRINT,
+   PROF_SHOW_SEQ,
+   PROF_EXTI,
+   PROF_RNG,
+   PROF_ZONE_COUNT
+} PROF_Zone;
+
+typedef struct {
+   uint32_t count;
+   uint32_t min;
+   uint32_t max;
+   uint64_t total;                  // mean = total / count
+   uint32_t hist[PROF_HIST_BINS];
+} PROF_Stats;
+
+#define PROF_BEGIN(zone)  uint32_t prof_t0_##zone = DWT->CYCCNT
+#define PROF_END(zone)    prof_record(zone, DWT->CYCCNT - prof_t0_##zone)
+
+// ---------- Function Prototypes --------------------------------------------
+void prof_init(void);
+void prof_record(PROF_Zone zone, uint32_t cycles);
+void prof_reset(void);
+const PROF_Stats *prof_get(PROF_Zone zone);
+void prof_dump(void);
+
+#else
+
+#define PROF_BEGIN(zone)
+#define PROF_END(zone)    ((void) 0)
+
+#endif // PROF_ENABLE
+
+#endif // PROF_H
@@ -0,0 +1,156 @@
+/**
+ * @file profile.c
+ * @brief per-player profiles in the 24LC256, keyed by initials
+ *
+ *  - Erased slot (name byte 0xFF) = free; a slot failing its CRC-8 is
+ *    treated as taken by someone else so the probe goes on past it
+ *  - An update rewrites only its own 12-byte slot
+ *  - A failed bucket read ends the probe with PF_IO_ERROR; nothing is
+ *    written, since the slot picked from unread data could be anyone's
+ *
+ * @date Dec. 17, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#include "profile.h"
+#include <string.h>
+
+#define SLOT_FREE   0xFF
+#define PF_IO_ERROR 0xFFFF       // probe result: a bucket read failed
+
+static PF_Stats pf_stats;
+
+static inline uint16_t bucket_addr(uint8_t b) {
+   return PF_START + (uint16_t) b * EEPROM_PAGE_SIZE;
+}
+
+static uint8_t hash_name(const char *name) {
+   uint32_t h = 2166136261u;
+   for (uint8_t i = 0; i < NAME_LEN; i++) {
+      h = (h ^ (uint8_t) name[i]) * 16777619u;
+   }
+   return h % PF_BUCKETS;
+}
+
+// CRC-8 (poly 0x07)
+static uint8_t crc8(const uint8_t *p, uint8_t n) {
+   uint8_t crc = 0;
+   while (n--) {
+      crc ^= *p++;
+      for (uint8_t b = 0; b < 8; b++) {
+         crc = (crc & 0x80) ? (uint8_t) ((crc << 1) ^ 0x07) : (crc << 1);
+      }
+   }
+   return crc;
+}
+
+static void pack(const Profile *p, uint8_t *s) {
+   memcpy(s, p->name, NAME_LEN);
+   s[3] = p->best >> 8;
+   s[4] = p->best & 0xFF;
+   s[5] = p->games >> 8;
+   s[6] = p->games & 0xFF;
+   s[7] = p->mean_ms >> 8;
+   s[8] = p->mean_ms & 0xFF;
+   s[9] = p->presses >> 8;
+   s[10] = p->presses & 0xFF;
+   s[11] = crc8(s, PF_SLOT_SIZE - 1);
+}
+
+static void unpack(const uint8_t *s, Profile *p) {
+   memcpy(p->name, s, NAME_LEN);
+   p->best = ((uint16_t) s[3] << 8) | s[4];
+   p->games = ((uint16_t) s[5] << 8) | s[6];
+   p->mean_ms = ((uint16_t) s[7] << 8) | s[8];
+   p->presses = ((uint16_t) s[9] << 8) | s[10];
+}
+
+// probe from the home bucket; returns the slot address holding name,
+// else the first free slot seen (*found = 0), 0 = table full,
+// PF_IO_ERROR = a bucket could not be read
+static uint16_t probe(const char *name, Profile *out, uint8_t *found) {
+   uint8_t page[EEPROM_PAGE_SIZE];
+   uint8_t b = hash_name(name);
+
+   *found = 0;
+   for (uint8_t n = 1; n <= PF_BUCKETS; n++) {
+      if (EEPROM_read_block(bucket_addr(b), page, sizeof(page))
+            != EEPROM_OK) {
+         pf_stats.io_errors++;
+         return PF_IO_ERROR;
+      }
+      pf_stats.page_reads++;
+      if (n > pf_stats.max_probe) {
+         pf_stats.max_probe = n;
+      }
+      for (uint8_t i = 0; i < PF_PER_BUCKET; i++) {
+         const uint8_t *s = &page[i * PF_SLOT_SIZE];
+         uint16_t addr = bucket_addr(b) + i * PF_SLOT_SIZE;
+         if (s[0] == SLOT_FREE) {
+            return addr;                 // never stored, probe ends here
+         }
+         if (memcmp(s, name, NAME_LEN) == 0
+               && crc8(s, PF_SLOT_SIZE - 1) == s[PF_SLOT_SIZE - 1]) {
+            unpack(s, out);
+            *found = 1;
+            return addr;
+         }
+      }
+      b = (b + 1) % PF_BUCKETS;
+   }
+   return 0;
+}
+
+uint8_t PF_lookup(const char *name, Profile *out) {
+   uint8_t found;
+
+   pf_stats.lookups++;
+   probe(name, out, &found);
+   return found;
+}
+
+uint8_t PF_record_game(const char *name, uint16_t score, uint16_t mean_ms,
+      uint16_t presses) {
+   Profile p;
+   uint8_t slot[PF_SLOT_SIZE];
+   uint8_t found;
+   uint8_t best = 0;
+
+   uint16_t addr = probe(name, &p, &found);
+   if (addr == PF_IO_ERROR) {
+      return 0;
+   }
+   if (addr == 0) {
+      pf_stats.full++;
+      return 0;
+   }
+   if (!found) {
+      memcpy(p.name, name, NAME_LEN);
+      p.best = 0;
+      p.games = 0;
+      p.mean_ms = 0;
+      p.presses = 0;
+   }
+   if (score > p.best || !found) {
+      p.best = score;
+      best = 1;
+   }
+   if (p.games < 0xFFFF) {
+      p.games++;
+   }
+   // running mean weighted by presses (press count saturates)
+   uint32_t n = p.presses;
+   if (presses) {
+      p.mean_ms = (uint16_t) (((uint32_t) p.mean_ms * n
+            + (uint32_t) mean_ms * presses) / (n + presses));
+      p.presses = (n + presses > 0xFFFF) ? 0xFFFF : (uint16_t) (n + presses);
+   }
+
+   pack(&p, slot);
+   EEPROM_write_page(addr, slot, sizeof(slot));
+   return best;
+}
+
+const PF_Stats *PF_get_stats(void) {
+   return &pf_stats;
+}
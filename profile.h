@@ -0,0 +1,65 @@
+/**
+ * @file profile.h
+ * @brief Header per-player profiles in the 24LC256, keyed by initials
+ *
+ *  - 12-byte slots, 5 per 64-byte page (bucket), 32 buckets after the
+ *    telemetry ring: [name:3][best:2][games:2][mean ms:2][presses:2][crc8:1]
+ *  - FNV-1a of the initials picks the home bucket, a full bucket probes
+ *    the next one (open addressing), so a lookup reads one page, rarely two
+ *  - Profiles are never deleted, so an empty slot ends the probe
+ *
+ * @date Dec. 17, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#ifndef SRC_PROFILE_H_
+#define SRC_PROFILE_H_
+
+#ifndef EEPROM_SIM
+#include "stm32l4xx.h"
+#endif
+#include <stdint.h>
+#include "EEPROM.h"
+
+#define PF_START       0x7800
+#define PF_END         0x8000
+#define PF_BUCKETS     ((PF_END - PF_START) / EEPROM_PAGE_SIZE)
+#define PF_SLOT_SIZE   12
+#define PF_PER_BUCKET  (EEPROM_PAGE_SIZE / PF_SLOT_SIZE)
+#define PF_CAPACITY    (PF_BUCKETS * PF_PER_BUCKET)       // 160 players
+
+typedef struct {
+    char name[NAME_LEN];
+    uint16_t best;           // personal best score
+    uint16_t games;          // games finished
+    uint16_t mean_ms;        // mean reaction time over all presses
+    uint16_t presses;        // presses behind mean_ms (saturates)
+} Profile;
+
+typedef struct {
+    uint32_t lookups;
+    uint32_t page_reads;     // bucket reads by lookups and updates
+    uint32_t max_probe;      // most buckets read by one lookup
+    uint32_t full;           // updates dropped, table full
+    uint32_t io_errors;      // lookups/updates dropped on a failed read
+} PF_Stats;
+
+/**
+ * @brief find the profile for name
+ *
+ * @return 1 = found (out filled), 0 = new player or read failed
+ */
+uint8_t PF_lookup(const char *name, Profile *out);
+
+/**
+ * @brief fold a finished game into name's profile, creating it if needed
+ *
+ * @param mean_ms  mean reaction time of the game, presses = how many
+ * @return 1 = new personal best, 0 = not, table full or read failed
+ */
+uint8_t PF_record_game(const char *name, uint16_t score, uint16_t mean_ms,
+      uint16_t presses);
+
+const PF_Stats *PF_get_stats(void);
+
+#endif /* SRC_PROFILE_H_ */
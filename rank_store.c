@@ -0,0 +1,330 @@
+/**
+ * @file rank_store.c
+ * @brief all-time ranking table paged in the 24LC256
+ *
+ *  - Logical page i holds ranks just below logical page i-1, so the RAM
+ *    index (min score per page) is sorted and binary searchable
+ *  - Directory entry with phys = 0xFF ends the list (erased part = empty)
+ *  - Data and directory writes go straight to the part with page writes
+ *  - A split writes the new page, then the directory, then the old page;
+ *    a full old page the directory gives half its entries to is a split
+ *    cut short, only that first half is still its own
+ *  - A failed directory read leaves the table offline: no inserts, so a
+ *    bus fault at mount cannot overwrite pages the index doesn't know of
+ *
+ * @date Dec. 9, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#include "rank_store.h"
+#include <string.h>
+
+#define RS_NONE       0xFF
+#define RS_PAGE_BYTES (1 + RS_PER_PAGE * PLAYER_REC_SIZE)
+
+typedef struct {
+    uint8_t phys;           // data page number in the region
+    uint8_t count;          // entries in that page
+    uint16_t min;           // lowest score in that page
+} PageIdx;
+
+typedef struct {
+    uint8_t count;
+    Player e[RS_PER_PAGE];
+} DataPage;
+
+static PageIdx idx[RS_DATA_PAGES];       // logical (rank) order
+static uint8_t n_pages;
+static uint16_t total;
+static uint8_t in_use[(RS_DATA_PAGES + 7) / 8];
+static uint8_t offline;                  // directory unreadable at mount
+
+static DataPage pg_a, pg_b;              // never more than two in RAM
+
+static inline uint16_t data_addr(uint8_t phys) {
+   return RS_DATA_ADDR + (uint16_t) phys * EEPROM_PAGE_SIZE;
+}
+
+static void mark(uint8_t phys, uint8_t used) {
+   if (used) {
+      in_use[phys / 8] |= (1u << (phys % 8));
+   } else {
+      in_use[phys / 8] &= ~(1u << (phys % 8));
+   }
+}
+
+static uint8_t alloc_page(void) {
+   for (uint8_t p = 0; p < RS_DATA_PAGES; p++) {
+      if (!(in_use[p / 8] & (1u << (p % 8)))) {
+         mark(p, 1);
+         return p;
+      }
+   }
+   return RS_NONE;
+}
+
+// load logical page i
+static EEPROM_Status load_page(uint8_t i, DataPage *pg) {
+   uint8_t buf[RS_PAGE_BYTES];
+
+   EEPROM_Status st = EEPROM_read_block(data_addr(idx[i].phys), buf,
+         sizeof(buf));
+   if (st != EEPROM_OK) {
+      pg->count = 0;
+      return st;
+   }
+   pg->count = (buf[0] > RS_PER_PAGE) ? 0 : buf[0];
+   if (pg->count == RS_PER_PAGE && idx[i].count == RS_PER_PAGE / 2) {
+      pg->count = RS_PER_PAGE / 2;       // torn split, rest is in page i+1
+   }
+   for (uint8_t i = 0; i < pg->count; i++) {
+      unpackPlayer(&buf[1 + i * PLAYER_REC_SIZE], &pg->e[i]);
+   }
+   return EEPROM_OK;
+}
+
+static void store_page(uint8_t phys, const DataPage *pg) {
+   uint8_t buf[RS_PAGE_BYTES];
+
+   buf[0] = pg->count;
+   for (uint8_t i = 0; i < pg->count; i++) {
+      packPlayer(&pg->e[i], &buf[1 + i * PLAYER_REC_SIZE]);
+   }
+   EEPROM_write_page(data_addr(phys), buf, 1 + pg->count * PLAYER_REC_SIZE);
+}
+
+// refresh the RAM index entry of logical page i from its RAM copy
+static void index_page(uint8_t i, uint8_t phys, const DataPage *pg) {
+   idx[i].phys = phys;
+   idx[i].count = pg->count;
+   idx[i].min = pg->e[pg->count - 1].score;
+}
+
+// persist directory entries first..last (entry n_pages is the terminator)
+static void dir_write(uint8_t first, uint8_t last) {
+   uint8_t buf[EEPROM_PAGE_SIZE];
+   uint16_t addr = RS_DIR_ADDR + first * RS_DIR_ENTRY_SIZE;
+   uint8_t len = 0;
+
+   for (uint16_t i = first; i <= last && i < RS_DATA_PAGES; i++) {
+      if (i < n_pages) {
+         buf[len++] = idx[i].phys;
+         buf[len++] = idx[i].count;
+         buf[len++] = idx[i].min >> 8;
+         buf[len++] = idx[i].min & 0xFF;
+      } else if (i < RS_DATA_PAGES) {
+         memset(&buf[len], RS_NONE, RS_DIR_ENTRY_SIZE);
+         len += RS_DIR_ENTRY_SIZE;
+      }
+      if (len == sizeof(buf)) {
+         EEPROM_write_page(addr, buf, len);
+         addr += len;
+         len = 0;
+      }
+   }
+   if (len) {
+      EEPROM_write_page(addr, buf, len);
+   }
+}
+
+// first logical page whose lowest score is below score
+static uint8_t find_page(uint16_t score) {
+   uint8_t lo = 0;
+   uint8_t hi = n_pages;
+   while (lo < hi) {
+      uint8_t mid = (lo + hi) / 2;
+      if (idx[mid].min >= score) {
+         lo = mid + 1;
+      } else {
+         hi = mid;
+      }
+   }
+   return lo;
+}
+
+// first entry in pg whose score is below score (ties rank below)
+static uint8_t find_slot(const DataPage *pg, uint16_t score) {
+   uint8_t lo = 0;
+   uint8_t hi = pg->count;
+   while (lo < hi) {
+      uint8_t mid = (lo + hi) / 2;
+      if (pg->e[mid].score >= score) {
+         lo = mid + 1;
+      } else {
+         hi = mid;
+      }
+   }
+   return lo;
+}
+
+static void page_insert(DataPage *pg, uint8_t pos, const char *name,
+      uint16_t score) {
+   for (uint8_t j = pg->count; j > pos; j--) {
+      pg->e[j] = pg->e[j - 1];
+   }
+   memcpy(pg->e[pos].name, name, NAME_LEN);
+   pg->e[pos].score = score;
+   pg->count++;
+}
+
+void RS_mount(void) {
+   uint8_t buf[EEPROM_PAGE_SIZE];
+   uint8_t done = 0;
+
+   n_pages = 0;
+   total = 0;
+   offline = 0;
+   memset(in_use, 0, sizeof(in_use));
+
+   for (uint16_t addr = RS_DIR_ADDR; addr < RS_DATA_ADDR && !done;
+         addr += sizeof(buf)) {
+      if (EEPROM_read_block(addr, buf, sizeof(buf)) != EEPROM_OK) {
+         offline = 1;
+         return;
+      }
+      for (uint8_t k = 0; k < sizeof(buf); k += RS_DIR_ENTRY_SIZE) {
+         uint8_t phys = buf[k];
+         uint8_t count = buf[k + 1];
+         if (n_pages >= RS_DATA_PAGES || phys >= RS_DATA_PAGES
+               || (in_use[phys / 8] & (1u << (phys % 8))) || count == 0
+               || count > RS_PER_PAGE) {
+            done = 1;                    // terminator or damaged entry
+            break;
+         }
+         mark(phys, 1);
+         idx[n_pages].phys = phys;
+         idx[n_pages].count = count;
+         idx[n_pages].min = ((uint16_t) buf[k + 2] << 8) | buf[k + 3];
+         total += count;
+         n_pages++;
+      }
+   }
+}
+
+uint16_t RS_count(void) {
+   return total;
+}
+
+uint8_t RS_insert(const char *name, uint16_t score) {
+   if (offline) {
+      return 0;
+   }
+   if (n_pages == 0) {
+      uint8_t phys = alloc_page();
+      pg_a.count = 0;
+      page_insert(&pg_a, 0, name, score);
+      store_page(phys, &pg_a);
+      index_page(0, phys, &pg_a);
+      n_pages = 1;
+      total = 1;
+      dir_write(0, 1);
+      return 1;
+   }
+
+   uint8_t i = find_page(score);
+   if (i == n_pages) {
+      i = n_pages - 1;                   // lowest so far, tail of last page
+   }
+   if (load_page(i, &pg_a) != EEPROM_OK) {
+      return 0;                          // page unknown, don't rewrite it
+   }
+   uint8_t pos = find_slot(&pg_a, score);
+
+   if (pg_a.count < RS_PER_PAGE) {
+      page_insert(&pg_a, pos, name, score);
+      store_page(idx[i].phys, &pg_a);
+      index_page(i, idx[i].phys, &pg_a);
+      dir_write(i, i);
+      total++;
+      return 1;
+   }
+
+   uint8_t phys = alloc_page();
+   if (phys == RS_NONE) {
+      // table full: make room at the bottom of the rankings
+      if (i == n_pages - 1) {
+         if (pos == RS_PER_PAGE) {
+            return 0;                    // would rank last, not kept
+         }
+         pg_a.count--;                   // drop the lowest entry
+         page_insert(&pg_a, pos, name, score);
+         store_page(idx[i].phys, &pg_a);
+         index_page(i, idx[i].phys, &pg_a);
+         dir_write(i, i);
+         return 1;
+      }
+      n_pages--;                         // drop the lowest page
+      total -= idx[n_pages].count;
+      phys = idx[n_pages].phys;
+      dir_write(n_pages, n_pages);       // off the directory before reuse
+   }
+
+   // split: upper half stays in page i, lower half moves to the new page.
+   // The new page and the directory go first, so until page i is
+   // rewritten it reads as its first half (load_page); a score bound for
+   // page i is only added once the split is on the part.
+   uint8_t half = RS_PER_PAGE / 2;
+   pg_b.count = RS_PER_PAGE - half;
+   memcpy(pg_b.e, &pg_a.e[half], pg_b.count * sizeof(Player));
+   pg_a.count = half;
+   if (pos > half) {
+      page_insert(&pg_b, pos - half, name, score);
+   }
+   store_page(phys, &pg_b);
+
+   for (uint8_t j = n_pages; j > i + 1; j--) {
+      idx[j] = idx[j - 1];
+   }
+   index_page(i, idx[i].phys, &pg_a);
+   index_page(i + 1, phys, &pg_b);
+   n_pages++;
+   dir_write(i, n_pages);               // entries after i moved down one
+
+   if (pos <= half) {
+      page_insert(&pg_a, pos, name, score);
+   }
+   store_page(idx[i].phys, &pg_a);
+   if (pos <= half) {
+      index_page(i, idx[i].phys, &pg_a);
+      dir_write(i, i);
+   }
+   total++;
+   return 1;
+}
+
+uint16_t RS_rank_of(uint16_t score) {
+   uint16_t rank = 0;
+   uint8_t i = find_page(score);
+
+   for (uint8_t j = 0; j < i; j++) {
+      rank += idx[j].count;
+   }
+   if (i < n_pages) {
+      if (load_page(i, &pg_a) != EEPROM_OK) {
+         return 0;                       // rank inside page i unknown
+      }
+      rank += find_slot(&pg_a, score);
+   }
+   return rank + 1;
+}
+
+uint16_t RS_read(uint16_t first, Player *out, uint16_t n) {
+   uint16_t copied = 0;
+   uint16_t skip = first;
+   uint8_t i = 0;
+
+   while (i < n_pages && skip >= idx[i].count) {
+      skip -= idx[i].count;
+      i++;
+   }
+   for (; i < n_pages && copied < n; i++) {
+      if (load_page(i, &pg_a) != EEPROM_OK) {
+         break;
+      }
+      for (uint8_t j = skip; j < pg_a.count && copied < n; j++) {
+         out[copied++] = pg_a.e[j];
+      }
+      skip = 0;
+   }
+   return copied;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file rank_store.h
+ * @brief Header all-time ranking table paged in the 24LC256
+ *
+ *  - Sorted entries (highest score first) in fixed 64-byte data pages,
+ *    [count:1][12 x (name:3, score:2)]
+ *  - Directory of pages in rank order: [phys:1][count:1][min score:2]
+ *    per page, read once at mount into a RAM index (720 bytes)
+ *  - Insert, rank lookup and range reads touch at most two data pages
+ *  - Full page splits in half; when no page is free, the lowest-ranked
+ *    page is dropped to make room
+ *
+ * @date Dec. 9, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#ifndef SRC_RANK_STORE_H_
+#define SRC_RANK_STORE_H_
+
+#ifndef EEPROM_SIM
+#include "stm32l4xx.h"
+#endif
+#include <stdint.h>
+#include "EEPROM.h"
+
+#define RS_DIR_ADDR        0x1000            // directory, 4 bytes per page
+#define RS_DATA_ADDR       0x1300            // first data page
+#define RS_END_ADDR        0x4000
+#define RS_DATA_PAGES      ((RS_END_ADDR - RS_DATA_ADDR) / EEPROM_PAGE_SIZE)
+#define RS_PER_PAGE        12
+#define RS_DIR_ENTRY_SIZE  4
+#define RS_CAPACITY        (RS_DATA_PAGES * RS_PER_PAGE)   // 2160 entries
+
+/**
+ * @brief read the directory and build the RAM page index; if the read
+ *        fails the table stays offline (RS_insert refuses) until remounted
+ */
+void RS_mount(void);
+
+/**
+ * @brief number of ranked entries
+ */
+uint16_t RS_count(void);
+
+/**
+ * @brief insert a score in rank order (ties rank below older entries)
+ *
+ * @return 1 = stored, 0 = table full and score too low to enter, or
+ *         the table is offline / its page could not be read
+ */
+uint8_t RS_insert(const char *name, uint16_t score);
+
+/**
+ * @brief rank a score would get if inserted now
+ *
+ * @return 1-based rank, 0 if the page it falls in could not be read
+ */
+uint16_t RS_rank_of(uint16_t score);
+
+/**
+ * @brief copy up to n entries starting at 0-based rank first
+ *        (top-N query is RS_read(0, out, N))
+ *
+ * @return number of entries copied (short if a page read fails)
+ */
+uint16_t RS_read(uint16_t first, Player *out, uint16_t n);
+
+#endif /* SRC_RANK_STORE_H_ */
@@ -19,11 +19,13 @@
   ******************************************************************************
   * REVISION HISTORY
   * 11/19/25	Created file
+  * 12/30/25	rng() is a profiling zone
   ******************************************************************************
 */
 
 #include "rng.h"
 #include "main.h"
+#include "prof.h"
 
 /*
  * Function 1/2:  rng_init
@@ -54,6 +56,7 @@ void rng_init(void)
  *  returns: random value from 0.. 4294967296
  */
 uint32_t rng(void) {
+    PROF_BEGIN(PROF_RNG);
 
     // Simple polling read with basic error handling
     // Assumes initialize_rng() enabled HSI48 + RNGEN
@@ -69,5 +72,7 @@ uint32_t rng(void) {
         // optionally add a small software watchdog to avoid infinite loop
     }
 
-    return RNG->DR;  // 32-bit random value
+    uint32_t value = RNG->DR;  // 32-bit random value
+    PROF_END(PROF_RNG);
+    return value;
 }
@@ -0,0 +1,183 @@
+/*
+------------------------------------------------------------------------------
+swtimer.c
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 swtimer.c
+******************************************************************************
+* @file           : swtimer.c
+* @brief          : one-shot/periodic software timers on TIM2 compare 1
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/26/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2
+* wiring       	  : n/a
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/26/2025      :	Created file
+* 12/29/2025      :	swt_resync() after a Stop 2 timebase jump, waits in pm_idle
+******************************************************************************
+*/
+
+#include "swtimer.h"
+#include "delay.h"
+#include "lowpower.h"
+
+// running timers sorted by due time; CCR1 holds the head's due time so
+// TIM2 interrupts only when something actually expires
+static SWT_Timer *head;
+
+static inline int32_t until(uint32_t due, uint32_t now) {
+   return (int32_t) (due - now);     // wrap-safe for gaps under ~35 min
+}
+
+static void insert(SWT_Timer *t) {
+   SWT_Timer **pp = &head;
+   while (*pp && until((*pp)->due_us, t->due_us) <= 0)
+      pp = &(*pp)->next;             // equal due times keep start order
+   t->next = *pp;
+   *pp = t;
+}
+
+static void unlink(SWT_Timer *t) {
+   for (SWT_Timer **pp = &head; *pp; pp = &(*pp)->next) {
+      if (*pp == t) {
+         *pp = t->next;
+         return;
+      }
+   }
+}
+
+// point compare 1 at the head; an already-late head fires right away
+static void arm(void) {
+   if (!head) {
+      TIM2->DIER &= ~TIM_DIER_CC1IE;
+      return;
+   }
+   TIM2->CCR1 = head->due_us;
+   TIM2->SR = ~TIM_SR_CC1IF;
+   TIM2->DIER |= TIM_DIER_CC1IE;
+   if (until(head->due_us, TIM2->CNT) <= 0)
+      TIM2->EGR = TIM_EGR_CC1G;      // missed the match, force the event
+}
+
+// re-check the head after the timebase jumped (Stop 2 compensation):
+// a due time that was skipped over never matches CCR1 on its own
+void swt_resync(void) {
+   uint32_t primask = __get_PRIMASK();
+   __disable_irq();
+   arm();
+   __set_PRIMASK(primask);
+}
+
+/*
+ * Function 1: swt_start_us
+ * --------------------
+ * (re)starts t: cb(arg) runs delay_us from now, then every period_us
+ *    if period_us is not 0. Restarting a running timer moves it.
+ *
+ *	takes in: t, delay_us, period_us, cb, arg
+ *
+ *  returns: nothing
+ */
+void swt_start_us(SWT_Timer *t, uint32_t delay_us, uint32_t period_us,
+      SWT_Callback cb, void *arg) {
+   uint32_t primask = __get_PRIMASK();
+   __disable_irq();
+   if (t->active)
+      unlink(t);
+   t->due_us = get_us() + delay_us;
+   t->period_us = period_us;
+   t->cb = cb;
+   t->arg = arg;
+   t->active = 1;
+   insert(t);
+   arm();
+   __set_PRIMASK(primask);
+}
+
+void swt_start_ms(SWT_Timer *t, uint32_t delay_ms, uint32_t period_ms,
+      SWT_Callback cb, void *arg) {
+   swt_start_us(t, SWT_MS(delay_ms), SWT_MS(period_ms), cb, arg);
+}
+
+void swt_stop(SWT_Timer *t) {
+   uint32_t primask = __get_PRIMASK();
+   __disable_irq();
+   if (t->active) {
+      unlink(t);
+      t->active = 0;
+      arm();
+   }
+   __set_PRIMASK(primask);
+}
+
+uint8_t swt_active(const SWT_Timer *t) {
+   return t->active;
+}
+
+// 1 and the TIM2 count of the next expiry, or 0 when nothing is running
+uint32_t swt_next_due(uint32_t *due_us) {
+   uint32_t primask = __get_PRIMASK();
+   __disable_irq();
+   uint32_t any = (head != 0);
+   if (any)
+      *due_us = head->due_us;
+   __set_PRIMASK(primask);
+   return any;
+}
+
+/*
+ * Function 2: swt_expire
+ * --------------------
+ * called from TIM2_IRQHandler on compare 1: runs every timer that is
+ *    due, re-queues periodic ones at due + period (no drift), re-arms
+ *
+ *	takes in: nothing
+ *
+ *  returns: nothing
+ */
+void swt_expire(void) {
+   while (head && until(head->due_us, TIM2->CNT) <= 0) {
+      SWT_Timer *t = head;
+      head = t->next;
+      if (t->period_us) {
+         t->due_us += t->period_us;
+         insert(t);
+      } else {
+         t->active = 0;
+      }
+      t->cb(t->arg);                 // may restart or stop any timer
+   }
+   arm();
+}
+
+static void wake(void *arg) {
+   *(volatile uint8_t*) arg = 1;
+}
+
+// blocking wait that sleeps (WFI) instead of spinning; other
+// interrupts keep being served meanwhile
+void swt_wait_us(uint32_t us) {
+   SWT_Timer t = { 0 };
+   volatile uint8_t done = 0;
+   swt_start_us(&t, us, 0, wake, (void*) &done);
+   __disable_irq();
+   while (!done) {
+      pm_idle();                     // Sleep or Stop 2 until t is due
+      __enable_irq();
+      __disable_irq();
+   }
+   __enable_irq();
+}
+
+void swt_wait_ms(uint32_t ms) {
+   swt_wait_us(SWT_MS(ms));
+}
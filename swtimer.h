@@ -0,0 +1,64 @@
+/*
+------------------------------------------------------------------------------
+swtimer.h
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 swtimer.h
+******************************************************************************
+* @file           : swtimer.h
+* @brief          : header for swtimer.c (one-shot/periodic software timers)
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/26/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2
+* wiring       	  : n/a
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/26/2025      :	Created file
+* 12/29/2025      :	swt_resync()
+******************************************************************************
+*/
+
+// ----------------------------------------------- #includes for swtimer.c --
+#ifndef SWTIMER_H
+#define SWTIMER_H
+
+#include "stm32l4xx_hal.h"
+#include <stdint.h>
+
+// runs in the TIM2 interrupt: keep it short (GPIO, flags, posting work)
+typedef void (*SWT_Callback)(void *arg);
+
+// owned by the caller (usually static), linked in while running
+typedef struct SWT_Timer {
+   struct SWT_Timer *next;
+   uint32_t due_us;                 // TIM2 count it fires at
+   uint32_t period_us;              // 0 = one-shot
+   SWT_Callback cb;
+   void *arg;
+   uint8_t active;
+} SWT_Timer;
+
+#define SWT_MS(ms) ((uint32_t) (ms) * 1000u)
+
+// ---------- Function Prototypes --------------------------------------------
+void swt_start_us(SWT_Timer *t, uint32_t delay_us, uint32_t period_us,
+      SWT_Callback cb, void *arg);
+void swt_start_ms(SWT_Timer *t, uint32_t delay_ms, uint32_t period_ms,
+      SWT_Callback cb, void *arg);
+void swt_stop(SWT_Timer *t);
+uint8_t swt_active(const SWT_Timer *t);
+uint32_t swt_next_due(uint32_t *due_us);
+void swt_wait_us(uint32_t us);
+void swt_wait_ms(uint32_t ms);
+void swt_expire(void);
+void swt_resync(void);
+
+#endif // SWTIMER_H
@@ -0,0 +1,320 @@
+/**
+ * @file telemetry.c
+ * @brief per-round telemetry ring in the spare 24LC256 space
+ *
+ *  - Page p of the current lap holds seq base + p, so the head is the last
+ *    page where that holds; erased or older-lap pages break the chain
+ *  - The head page lives in RAM, appends write only the new record bytes
+ *  - A torn record fails its CRC-8 and marks the end of the page
+ *  - If a read fails at mount the head is unknown, so the ring goes
+ *    offline and appends are dropped rather than written over old pages
+ *
+ * @date Dec. 16, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#include "telemetry.h"
+#include "EEPROM.h"
+#include "eeprom_async.h"
+#include <string.h>
+
+#define PAGE_HDR   4
+#define SEQ_BLANK  0xFFFFFFFFu
+#define REC_MAX    (EEPROM_PAGE_SIZE - PAGE_HDR)     // len + payload + crc
+#define LEN_BLANK  0xFF
+
+static uint8_t page_buf[EEPROM_PAGE_SIZE];   // head page
+static uint8_t head;                         // head page number
+static uint8_t fill;                         // next free byte in page_buf
+static uint32_t head_seq;
+static uint8_t empty;                        // nothing written yet
+static uint8_t offline;                      // mount could not read the ring
+static uint8_t read_failed;                  // a read_seq failed
+static EEPROM_Xfer tlm_xfer;
+static TLM_Stats tlm_stats;
+
+static uint32_t session_ms;                  // reaction times this game
+static uint16_t session_presses;
+
+static uint8_t exp_page;                     // export cursor
+static uint16_t exp_left;
+
+static inline uint16_t page_addr(uint8_t p) {
+   return TLM_START + (uint16_t) p * EEPROM_PAGE_SIZE;
+}
+
+static uint32_t get_seq(const uint8_t *b) {
+   return b[0] | ((uint32_t) b[1] << 8) | ((uint32_t) b[2] << 16)
+         | ((uint32_t) b[3] << 24);
+}
+
+// a failed read looks blank and sets read_failed
+static uint32_t read_seq(uint8_t p) {
+   uint8_t b[PAGE_HDR];
+   if (EEPROM_read_block(page_addr(p), b, sizeof(b)) != EEPROM_OK) {
+      tlm_stats.io_errors++;
+      read_failed = 1;
+      return SEQ_BLANK;
+   }
+   return get_seq(b);
+}
+
+// CRC-8 (poly 0x07), a record is at most 60 bytes
+static uint8_t crc8(const uint8_t *p, uint8_t n) {
+   uint8_t crc = 0;
+   while (n--) {
+      crc ^= *p++;
+      for (uint8_t b = 0; b < 8; b++) {
+         crc = (crc & 0x80) ? (uint8_t) ((crc << 1) ^ 0x07) : (crc << 1);
+      }
+   }
+   return crc;
+}
+
+static uint8_t put_varint(uint8_t *p, uint32_t v) {
+   uint8_t n = 0;
+   while (v >= 0x80) {
+      p[n++] = (uint8_t) v | 0x80;
+      v >>= 7;
+   }
+   p[n++] = (uint8_t) v;
+   return n;
+}
+
+static uint8_t get_varint(const uint8_t *p, uint8_t avail, uint32_t *v) {
+   uint8_t n = 0;
+   *v = 0;
+   while (n < avail && n < 5) {
+      *v |= (uint32_t) (p[n] & 0x7F) << (7 * n);
+      if (!(p[n++] & 0x80)) {
+         return n;
+      }
+   }
+   return 0;                             // ran off the record
+}
+
+// length of the valid record at off, 0 = blank, torn or past the page
+static uint8_t record_len(const uint8_t *page, uint8_t off) {
+   if (off + 2 > EEPROM_PAGE_SIZE || page[off] == LEN_BLANK) {
+      return 0;
+   }
+   uint8_t len = page[off];
+   if (off + 2 + len > EEPROM_PAGE_SIZE
+         || crc8(&page[off + 1], len) != page[off + 1 + len]) {
+      return 0;
+   }
+   return len + 2;
+}
+
+static void decode(const uint8_t *payload, uint8_t len, TLM_Round *r) {
+   uint8_t off = 1;
+   uint32_t v;
+   int32_t t = 0;
+
+   r->level = payload[0] >> 2;
+   r->outcome = payload[0] & 3;
+   r->presses = 0;
+   while (off < len && r->presses < TLM_MAX_PRESSES) {
+      uint8_t n = get_varint(&payload[off], len - off, &v);
+      if (n == 0) {
+         break;
+      }
+      off += n;
+      if (r->presses == 0) {
+         t = (int32_t) v;
+      } else {
+         t += (int32_t) (v >> 1) ^ -(int32_t) (v & 1);     // zigzag
+      }
+      r->react_ms[r->presses++] = (uint16_t) (t * TLM_TICK_MS);
+   }
+}
+
+void TLM_mount(void) {
+   read_failed = 0;
+   uint32_t seq0 = read_seq(0);
+
+   fill = PAGE_HDR;
+   offline = read_failed;
+   if (seq0 == SEQ_BLANK) {
+      empty = 1;
+      head = 0;
+      head_seq = 0;
+      return;
+   }
+   empty = 0;
+
+   // last page p with seq == seq0 + p (page 0 always qualifies)
+   uint16_t lo = 0;
+   uint16_t hi = TLM_PAGES;
+   while (hi - lo > 1) {
+      uint16_t mid = (lo + hi) / 2;
+      if (read_seq(mid) == seq0 + mid) {
+         lo = mid;
+      } else {
+         hi = mid;
+      }
+   }
+   head = lo;
+   head_seq = seq0 + lo;
+
+   if (!read_failed && EEPROM_read_block(page_addr(head), page_buf,
+         sizeof(page_buf)) != EEPROM_OK) {
+      tlm_stats.io_errors++;
+      read_failed = 1;
+   }
+   if (read_failed) {
+      offline = 1;
+      return;
+   }
+   uint8_t n;
+   while ((n = record_len(page_buf, fill)) != 0) {
+      fill += n;
+   }
+}
+
+void TLM_round_begin(TLM_Round *r, uint8_t level) {
+   r->level = level;
+   r->outcome = TLM_PASS;
+   r->presses = 0;
+}
+
+void TLM_round_press(TLM_Round *r, uint32_t react_ms) {
+   if (r->presses < TLM_MAX_PRESSES) {
+      r->react_ms[r->presses++] = (react_ms > 0xFFFF) ? 0xFFFF : react_ms;
+   }
+}
+
+void TLM_round_end(TLM_Round *r, TLM_Outcome outcome) {
+   r->outcome = outcome;
+}
+
+void TLM_session_begin(void) {
+   session_ms = 0;
+   session_presses = 0;
+}
+
+uint16_t TLM_session_mean_ms(uint16_t *presses) {
+   *presses = session_presses;
+   return session_presses ? (uint16_t) (session_ms / session_presses) : 0;
+}
+
+uint8_t TLM_log_round(const TLM_Round *r) {
+   uint8_t rec[REC_MAX];
+   uint8_t len = 1;
+   int32_t prev = 0;
+
+   for (uint8_t i = 0; i < r->presses && session_presses < 0xFFFF; i++) {
+      session_ms += r->react_ms[i];
+      session_presses++;
+   }
+   if (offline) {
+      return 0;
+   }
+
+   rec[1] = (uint8_t) ((r->level > 63 ? 63 : r->level) << 2) | (r->outcome & 3);
+   for (uint8_t i = 0; i < r->presses; i++) {
+      uint8_t tmp[5];
+      int32_t t = r->react_ms[i] / TLM_TICK_MS;
+      uint32_t v = (i == 0) ? (uint32_t) t
+            : ((uint32_t) (t - prev) << 1) ^ (uint32_t) ((t - prev) >> 31);
+      uint8_t n = put_varint(tmp, v);
+      if (2 + len + n > REC_MAX) {
+         tlm_stats.truncated++;          // keep what fits in one page
+         break;
+      }
+      memcpy(&rec[1 + len], tmp, n);
+      len += n;
+      prev = t;
+   }
+   rec[0] = len;
+   rec[1 + len] = crc8(&rec[1], len);
+   uint8_t size = len + 2;
+
+   // the engine still owns tlm_xfer and page_buf for the previous append;
+   // rounds are seconds apart, so drop this one rather than wait on the bus
+   if (tlm_xfer.status == EEPROM_XFER_QUEUED
+         || tlm_xfer.status == EEPROM_XFER_ACTIVE) {
+      tlm_stats.dropped++;
+      return 0;
+   }
+
+   uint8_t first = fill;
+   if (empty || fill + size > EEPROM_PAGE_SIZE) {
+      if (!empty) {
+         head = (head + 1) % TLM_PAGES;
+         head_seq++;
+      }
+      empty = 0;
+      memset(page_buf, 0xFF, sizeof(page_buf));
+      page_buf[0] = (uint8_t) head_seq;
+      page_buf[1] = (uint8_t) (head_seq >> 8);
+      page_buf[2] = (uint8_t) (head_seq >> 16);
+      page_buf[3] = (uint8_t) (head_seq >> 24);
+      fill = PAGE_HDR;
+      first = 0;                         // whole page, blanks the old lap
+      tlm_stats.pages++;
+   }
+   memcpy(&page_buf[fill], rec, size);
+   fill += size;
+
+   tlm_xfer.addr = page_addr(head) + first;
+   tlm_xfer.buf = &page_buf[first];
+   tlm_xfer.len = (first == 0) ? EEPROM_PAGE_SIZE : size;
+   tlm_xfer.dir = EEPROM_XFER_WRITE;
+   tlm_xfer.done = 0;
+   if (!EEPROM_submit(&tlm_xfer)) {
+      EEPROM_write_page(tlm_xfer.addr, tlm_xfer.buf, tlm_xfer.len);
+      tlm_stats.blocking++;
+   }
+
+   tlm_stats.rounds++;
+   tlm_stats.bytes += size;
+   return size;
+}
+
+void TLM_export_begin(void) {
+   if (empty) {
+      exp_left = 0;
+      return;
+   }
+   // wrapped once the page after the head holds the previous lap
+   uint8_t next = (head + 1) % TLM_PAGES;
+   if (next != 0 && read_seq(next) == head_seq + 1 - TLM_PAGES) {
+      exp_page = next;
+      exp_left = TLM_PAGES;
+   } else {
+      exp_page = 0;
+      exp_left = head + 1;
+   }
+}
+
+uint8_t TLM_export_next(TLM_Round *out, uint8_t max) {
+   uint8_t buf[EEPROM_PAGE_SIZE];
+   uint8_t found = 0;
+
+   if (exp_left == 0) {
+      return TLM_EXPORT_DONE;
+   }
+   EEPROM_Status st = EEPROM_read_block(page_addr(exp_page), buf, sizeof(buf));
+   exp_page = (exp_page + 1) % TLM_PAGES;
+   exp_left--;
+
+   if (st != EEPROM_OK) {
+      tlm_stats.io_errors++;             // skip the page, carry on
+      return 0;
+   }
+   if (get_seq(buf) == SEQ_BLANK) {
+      return 0;
+   }
+   uint8_t off = PAGE_HDR;
+   uint8_t n;
+   while (found < max && (n = record_len(buf, off)) != 0) {
+      decode(&buf[off + 1], n - 2, &out[found++]);
+      off += n;
+   }
+   return found;
+}
+
+const TLM_Stats *TLM_get_stats(void) {
+   return &tlm_stats;
+}
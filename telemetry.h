@@ -0,0 +1,102 @@
+/**
+ * @file telemetry.h
+ * @brief Header per-round telemetry ring in the spare 24LC256 space
+ *
+ *  - One record per round: level, outcome and the reaction time of every
+ *    press, times in TLM_TICK_MS units, first one as a varint and the rest
+ *    as zigzag varint deltas from the previous press
+ *  - Record: [len:1][level<<2 | outcome:1][varints...][crc8:1]
+ *  - Page: [seq:4][records...], pages written in order around the ring,
+ *    a new page is written whole so the previous lap's bytes are blanked
+ *  - Mount finds the head page by binary search on the page seq chain
+ *  - Export reads one page per call, so it can run between other work
+ *
+ * @date Dec. 16, 2025
+ * @author William Chung + Vanessa Guzman
+ */
+
+#ifndef SRC_TELEMETRY_H_
+#define SRC_TELEMETRY_H_
+
+#ifndef EEPROM_SIM
+#include "stm32l4xx.h"
+#endif
+#include <stdint.h>
+
+#define TLM_START        0x4000
+#define TLM_END          0x7800           // 224 pages, profiles follow
+#define TLM_PAGES        ((TLM_END - TLM_START) / 64)
+#define TLM_TICK_MS      4                // reaction time resolution
+#define TLM_MAX_PRESSES  32               // MAX_SEQ_LEN in led_timer.h
+#define TLM_EXPORT_DONE  0xFF
+
+typedef enum {
+    TLM_PASS = 0,            // whole sequence repeated
+    TLM_WRONG,               // wrong color
+    TLM_TIMEOUT              // answer window ran out
+} TLM_Outcome;
+
+typedef struct {
+    uint8_t level;
+    uint8_t outcome;                       // TLM_Outcome
+    uint8_t presses;
+    uint16_t react_ms[TLM_MAX_PRESSES];    // per press, since the previous
+} TLM_Round;
+
+typedef struct {
+    uint32_t rounds;         // records appended since boot
+    uint32_t bytes;          // record bytes appended since boot
+    uint32_t pages;          // pages started since boot
+    uint32_t truncated;      // records that dropped presses to fit a page
+    uint32_t blocking;       // appends written polled (engine queue full)
+    uint32_t io_errors;      // page reads that failed (mount, export)
+    uint32_t dropped;        // records dropped, previous append in flight
+} TLM_Stats;
+
+/**
+ * @brief find the head page and the end of its records; a failed read
+ *        leaves the ring offline (appends dropped) until the next mount
+ */
+void TLM_mount(void);
+
+/**
+ * @brief start a round / add one press / set how it ended
+ */
+void TLM_round_begin(TLM_Round *r, uint8_t level);
+void TLM_round_press(TLM_Round *r, uint32_t react_ms);
+void TLM_round_end(TLM_Round *r, TLM_Outcome outcome);
+
+/**
+ * @brief reset / read the reaction times seen by TLM_log_round since the
+ *        game started (feeds the player profile)
+ *
+ * @param presses  receives the number of presses behind the mean
+ * @return mean reaction time in ms, 0 if no presses
+ */
+void TLM_session_begin(void);
+uint16_t TLM_session_mean_ms(uint16_t *presses);
+
+/**
+ * @brief encode and append a round, the page write goes out async
+ *
+ * @return encoded record size in bytes, 0 = dropped (ring offline or
+ *         the previous append still on the bus)
+ */
+uint8_t TLM_log_round(const TLM_Round *r);
+
+/**
+ * @brief start an export from the oldest page still in the ring
+ */
+void TLM_export_begin(void);
+
+/**
+ * @brief read the next page (one burst) and decode its rounds
+ *
+ * @param out  room for max rounds
+ * @return rounds decoded, TLM_EXPORT_DONE once every page was read
+ */
+uint8_t TLM_export_next(TLM_Round *out, uint8_t max);
+
+const TLM_Stats *TLM_get_stats(void);
+
+#endif /* SRC_TELEMETRY_H_ */
@@ -0,0 +1,232 @@
+/*
+------------------------------------------------------------------------------
+term.c
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 term.c
+******************************************************************************
+* @file           : term.c
+* @brief          : shadow-screen VT100 renderer, sends only changed cells
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/21/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2
+* wiring       	  : PG7 as TX
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/21/2025      :	Created file
+******************************************************************************
+*/
+
+#include "term.h"
+#include "uart_tx.h"
+#include "vt100.h"
+#include <string.h>
+
+#define OUT_SIZE 128                 // staging buffer, one ring write each
+
+// back = what the screen should show, front = what the terminal shows
+static uint8_t back[TERM_ROWS][TERM_COLS];
+static uint8_t front[TERM_ROWS][TERM_COLS];
+static uint8_t dirty[TERM_ROWS];     // row has back != front somewhere
+static TERM_Stats term_stats;
+
+static char out[OUT_SIZE];
+static uint8_t out_len;
+static uint16_t frame_bytes;
+static VT_Cursor cursor;             // row 0 = position unknown
+
+static void out_flush(void) {
+   if (out_len) {
+      uart_tx_write(out, out_len);
+      frame_bytes += out_len;
+      out_len = 0;
+   }
+}
+
+static void out_bytes(const char *s, uint8_t n) {
+   if (out_len + n > OUT_SIZE) {
+      out_flush();
+   }
+   memcpy(&out[out_len], s, n);
+   out_len += n;
+}
+
+static inline uint8_t cell_bytes(uint8_t cell) {
+   return (cell & 0x80) ? 3 : 1;
+}
+
+static void out_cell(uint8_t cell) {
+   char glyph[3] = { (char) 0xE2, (char) 0x95, (char) cell };
+   if (cell & 0x80) {
+      out_bytes(glyph, 3);
+   } else {
+      out_bytes((const char*) &cell, 1);
+   }
+}
+
+// shortest cursor move, encoded straight into the staging buffer
+static void move_to(uint8_t row, uint8_t col) {
+   if (out_len + VT_MAX_SEQ > OUT_SIZE) {
+      out_flush();
+   }
+   out_len += vt_move(&cursor, &out[out_len], row, col);
+}
+
+// one UTF-8 / ASCII character of s (n bytes left) as a cell,
+// returns bytes consumed
+static uint8_t to_cell(const char *s, uint16_t n, uint8_t *cell) {
+   uint8_t c = (uint8_t) s[0];
+   if (c < 0x80) {
+      *cell = (c < ' ' || c > '~') ? ' ' : c;
+      return 1;
+   }
+   if (n >= 3 && c == 0xE2 && (uint8_t) s[1] == 0x95
+         && ((uint8_t) s[2] & 0xC0) == 0x80) {
+      *cell = (uint8_t) s[2];         // box-drawing block
+      return 3;
+   }
+   *cell = '?';                       // glyph outside the cell set
+   c = 1;
+   while (c < n && ((uint8_t) s[c] & 0xC0) == 0x80)
+      c++;
+   return c;
+}
+
+static inline void set_cell(uint8_t row, uint8_t col, uint8_t cell) {
+   if (row < 1 || row > TERM_ROWS || col < 1 || col > TERM_COLS)
+      return;
+   back[row - 1][col - 1] = cell;
+   dirty[row - 1] = 1;
+}
+
+/*
+ * Function 2: term_putn
+ * --------------------
+ * writes n bytes of s into the back buffer at row, col; nothing is
+ *    sent until term_flush. Text past the right edge is cut off.
+ *
+ *	takes in: row, col (1-based), s (ASCII or UTF-8 box glyphs), n
+ *
+ *  returns: cells written (columns advanced)
+ */
+uint8_t term_putn(uint8_t row, uint8_t col, const char *s, uint16_t n) {
+   uint8_t cell, cells = 0;
+   while (n && col + cells <= TERM_COLS) {
+      uint8_t used = to_cell(s, n, &cell);
+      s += used;
+      n -= used;
+      set_cell(row, col + cells++, cell);
+   }
+   return cells;
+}
+
+void term_put(uint8_t row, uint8_t col, const char *s) {
+   term_putn(row, col, s, strlen(s));
+}
+
+// s then spaces up to width, so a shorter value clears the old one
+void term_field(uint8_t row, uint8_t col, const char *s, uint8_t width) {
+   uint8_t n = term_putn(row, col, s, strlen(s));
+   for (; n < width; n++)
+      set_cell(row, col + n, ' ');
+}
+
+void term_fill(uint8_t row, uint8_t col, uint8_t cell, uint8_t n) {
+   while (n--)
+      set_cell(row, col++, cell);
+}
+
+// clears the real screen and both buffers
+void term_clear(void) {
+   memset(back, ' ', sizeof(back));
+   memset(front, ' ', sizeof(front));
+   memset(dirty, 0, sizeof(dirty));
+   char seq[VT_MAX_SEQ];
+   uart_tx_write(seq, vt_clear(&cursor, seq));
+}
+
+// screen was changed behind our back: next flush redraws every cell
+void term_invalidate(void) {
+   memset(front, 0, sizeof(front));  // 0 never matches a cell
+   memset(dirty, 1, sizeof(dirty));
+}
+
+/*
+ * Function 3: term_flush
+ * --------------------
+ * sends the cells where back differs from front. Runs of changes on a
+ *    row go out as one write; a gap of unchanged cells is resent when
+ *    that is cheaper than a CUF over it. The cursor is assumed unknown
+ *    at the start since other prints may have moved it.
+ *
+ *	takes in: nothing
+ *
+ *  returns: bytes sent for this frame
+ */
+uint16_t term_flush(void) {
+   uint16_t cells = 0;
+
+   frame_bytes = 0;
+   cursor.row = 0;
+   for (uint8_t r = 0; r < TERM_ROWS; r++) {
+      if (!dirty[r])
+         continue;
+      dirty[r] = 0;
+      uint8_t *b = back[r];
+      uint8_t *f = front[r];
+      uint8_t c = 0;
+      while (c < TERM_COLS) {
+         if (b[c] == f[c]) {
+            c++;
+            continue;
+         }
+         // grow the run while resending the gap beats jumping over it
+         uint8_t end = c;
+         uint8_t gap_bytes = 0;
+         for (uint8_t j = c + 1; j < TERM_COLS; j++) {
+            if (b[j] != f[j]) {
+               end = j;
+               gap_bytes = 0;
+            } else {
+               gap_bytes += cell_bytes(b[j]);
+               if (gap_bytes > vt_csi_len(VT_CUF, j - end))
+                  break;
+            }
+         }
+         move_to(r + 1, c + 1);
+         for (uint8_t j = c; j <= end; j++) {
+            out_cell(b[j]);
+            cells += (b[j] != f[j]);
+            f[j] = b[j];
+         }
+         // the last column leaves the cursor in the pending-wrap state
+         cursor.col = end + 2;
+         if (end + 1 == TERM_COLS)
+            cursor.row = 0;
+         c = end + 1;
+      }
+   }
+   out_flush();
+
+   if (frame_bytes) {
+      term_stats.frames++;
+      term_stats.bytes_total += frame_bytes;
+      term_stats.bytes_last = frame_bytes;
+      term_stats.cells_last = cells;
+      if (frame_bytes > term_stats.bytes_max)
+         term_stats.bytes_max = frame_bytes;
+   }
+   return frame_bytes;
+}
+
+const TERM_Stats *term_get_stats(void) {
+   return &term_stats;
+}
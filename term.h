@@ -0,0 +1,67 @@
+/*
+------------------------------------------------------------------------------
+term.h
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 term.h
+******************************************************************************
+* @file           : term.h
+* @brief          : header for term.c (shadow-screen VT100 renderer)
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/21/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2
+* wiring       	  : PG7 as TX
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/21/2025      :	Created file
+******************************************************************************
+*/
+
+// -------------------------------------------------- #includes for term.c --
+#ifndef TERM_H
+#define TERM_H
+
+#include "stm32l4xx_hal.h"
+#include <stdint.h>
+
+#define TERM_ROWS 40                // rows/cols are 1-based like VT100
+#define TERM_COLS 80
+
+// A cell is one byte: 0x20-0x7E is ASCII, 0x80-0xBF is the box-drawing
+// glyph U+2540+(cell-0x80), sent as E2 95 <cell>
+#define TERM_HORIZ 0x90             // ═
+#define TERM_VERT  0x91             // ║
+#define TERM_TL    0x94             // ╔
+#define TERM_TR    0x97             // ╗
+#define TERM_BL    0x9A             // ╚
+#define TERM_BR    0x9D             // ╝
+#define TERM_LT    0xA0             // ╠
+#define TERM_RT    0xA3             // ╣
+
+typedef struct {
+   uint32_t frames;                 // term_flush calls that sent something
+   uint32_t bytes_total;
+   uint16_t bytes_last;             // bytes sent by the last frame
+   uint16_t bytes_max;
+   uint16_t cells_last;             // cells changed in the last frame
+} TERM_Stats;
+
+// ---------- Function Prototypes --------------------------------------------
+void term_clear(void);
+void term_invalidate(void);
+uint8_t term_putn(uint8_t row, uint8_t col, const char *s, uint16_t n);
+void term_put(uint8_t row, uint8_t col, const char *s);
+void term_field(uint8_t row, uint8_t col, const char *s, uint8_t width);
+void term_fill(uint8_t row, uint8_t col, uint8_t cell, uint8_t n);
+uint16_t term_flush(void);
+const TERM_Stats *term_get_stats(void);
+
+#endif // TERM_H
@@ -0,0 +1,107 @@
+/**
+ * @file bench_fmt.c
+ * @brief fmt_print vs snprintf: same output, time per call
+ *
+ *  - Every case must print byte for byte what snprintf prints, fixed
+ *    point (%.2u etc., fmt only) is checked against fixed strings
+ *  - Timing: a leaderboard-row format, 2M calls each, TSC cycles on x86
+ *    hosts, ns elsewhere
+ *  - Code size comes from `size` on fmt.o at -Os (bench target); the
+ *    host libc printf is no stand-in for newlib's, so only fmt is sized
+ *
+ * @date Jan. 3, 2026
+ * @author William Chung + Vanessa Guzman
+ */
+
+#include "fmt.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define NOW()   __rdtsc()
+#define UNIT    "cycles"
+#else
+#define NOW()   ((unsigned long long) clock() * (1000000000ull / CLOCKS_PER_SEC))
+#define UNIT    "ns"
+#endif
+
+#define CALLS 2000000
+
+static int bad;
+
+uint16_t uart_tx_write(const char *buf, uint16_t len) {
+   (void) buf;
+   return len;
+}
+
+#define SAME(...) do { \
+   char a[64], b[64]; \
+   FMT_Sink k; \
+   fmt_buffer_sink(&k, a, sizeof(a)); \
+   uint16_t n1 = fmt_print(&k, __VA_ARGS__); \
+   int n2 = snprintf(b, sizeof(b), __VA_ARGS__); \
+   if (strcmp(a, b) || n1 != n2) { \
+      printf("MISMATCH \"%s\" vs snprintf \"%s\"\n", a, b); \
+      bad++; \
+   } \
+} while (0)
+
+#define FIXED(want, ...) do { \
+   char a[64]; \
+   FMT_Sink k; \
+   fmt_buffer_sink(&k, a, sizeof(a)); \
+   fmt_print(&k, __VA_ARGS__); \
+   if (strcmp(a, want)) { \
+      printf("MISMATCH \"%s\" want \"%s\"\n", a, want); \
+      bad++; \
+   } \
+} while (0)
+
+int main(void) {
+   char a[64];
+   FMT_Sink k;
+   volatile unsigned sum = 0;
+
+   SAME("%u", 0u);
+   SAME("%u", 4294967295u);
+   SAME("%d", -5);
+   SAME("%d", (int) 0x80000000);
+   SAME("%5d|", -42);
+   SAME("%-5d|", -42);
+   SAME("%05d", -42);
+   SAME("%05u", 42u);
+   SAME("%x %X", 0xbeefu, 0xbeefu);
+   SAME("%08x", 0x1fu);
+   SAME("%s|%-6s|%6s|", "ab", "cd", "ef");
+   SAME("%.3s", "ABCDEF");
+   SAME("%c%c", 'h', 'i');
+   SAME("100%%");
+   SAME("%*d", 6, 7);
+   SAME("%-*s|", 4, "a");
+   SAME("%lu", 123ul);
+   SAME("lit only");
+   SAME("%s", "");
+   FIXED("12.34", "%.2u", 1234u);
+   FIXED("0.05", "%.2u", 5u);
+   FIXED("-1.5", "%.1d", -15);
+   FIXED("  3.141", "%7.3u", 3141u);
+   FIXED("0.000", "%.3u", 0u);
+   FIXED("-0012.5", "%07.1d", -125);
+   printf("output: %s (%d mismatches)\n", bad ? "BAD" : "ok", bad);
+
+   unsigned long long t0 = NOW();
+   for (unsigned i = 0; i < CALLS; i++) {
+      fmt_buffer_sink(&k, a, sizeof(a));
+      sum += fmt_print(&k, "%-5u%.3s  %5u", i % 2000, "ABC", i * 7 % 60000);
+   }
+   unsigned long long t1 = NOW();
+   for (unsigned i = 0; i < CALLS; i++) {
+      sum += snprintf(a, sizeof(a), "%-5u%.3s  %5u", i % 2000, "ABC",
+            i * 7 % 60000);
+   }
+   unsigned long long t2 = NOW();
+   printf("row format: fmt_print %.1f %s, snprintf %.1f %s per call\n",
+         (double) (t1 - t0) / CALLS, UNIT, (double) (t2 - t1) / CALLS, UNIT);
+   return bad ? 1 : 0;
+}
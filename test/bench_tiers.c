@@ -0,0 +1,74 @@
+/**
+ * @file bench_tiers.c
+ * @brief save latency per storage tier on the simulated parts
+ *
+ *  - Simulated time: 24LC256 bus time + write cycles at 400 kHz, flash
+ *    program/erase times from the datasheet (flash_ee.c sim section)
+ *  - addScore = game-over cost now that every write is deferred
+ *  - save = full saveLeaderboard + flush of the new board, the cost
+ *    game over paid when the image was written synchronously
+ *  - persist = the rest PS_service does later at idle (rank store,
+ *    profile, journal flush)
+ *
+ * @date Jan. 3, 2026
+ * @author William Chung + Vanessa Guzman
+ */
+
+#include "EEPROM.h"
+#include "eeprom_sim.h"
+#include "eeprom_cache.h"
+#include "flash_ee.h"
+#include "persist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GAMES 300
+
+static Player board[MAX_PLAYERS];
+
+int main(void) {
+   static const char *names[] = { "external", "internal", "tiered" };
+   static const EE_Tier tiers[] = { EE_TIER_EXTERNAL, EE_TIER_INTERNAL,
+         EE_TIER_TIERED };
+
+   printf("%-8s %12s %12s %12s %8s\n", "tier", "addScore us", "save us",
+         "persist us", "reload");
+   for (uint8_t t = 0; t < 3; t++) {
+      uint64_t add = 0, persist = 0, save = 0;
+      Player ref[MAX_PLAYERS];
+
+      EE_sim_reset();
+      EE_cache_invalidate();
+      EEPROM_init();
+      EEPROM_set_tier(tiers[t]);
+      uint8_t n = loadLeaderboard(board);
+      EE_cache_flush();
+
+      srand(3);
+      for (int i = 0; i < GAMES; i++) {
+         char name[NAME_LEN] = { 'A' + i % 26, 'B', 'C' };
+         uint64_t t0 = EE_sim_time_us();
+         n = addScore(board, n, name, rand() % 9000);
+         uint64_t t1 = EE_sim_time_us();
+         saveLeaderboard(board, n);
+         EE_cache_flush();
+         uint64_t t2 = EE_sim_time_us();
+         PS_drain();
+         uint64_t t3 = EE_sim_time_us();
+         add += t1 - t0;
+         save += t2 - t1;
+         persist += t3 - t2;
+      }
+
+      memcpy(ref, board, sizeof(ref));
+      EE_cache_invalidate();
+      EEPROM_init();
+      uint8_t ok = loadLeaderboard(board) == n
+            && memcmp(ref, board, sizeof(ref)) == 0;
+      printf("%-8s %12.0f %12.0f %12.0f %8s\n", names[t],
+            (double) add / GAMES, (double) save / GAMES,
+            (double) persist / GAMES, ok ? "ok" : "BAD");
+   }
+   return 0;
+}
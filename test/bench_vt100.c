@@ -0,0 +1,150 @@
+/**
+ * @file bench_vt100.c
+ * @brief VT100 encoder vs the old cursor ladder: bytes on the wire and
+ *        host time per cursor move
+ *
+ *  - ladder() is the LPUART_Set_Cursor_Location body vt100.c replaced,
+ *    writing into a buffer instead of the UART (rows >= 100 or cols
+ *    >= 200 sent nothing, as before)
+ *  - Leaderboard table (uart.c layout): old = one ladder CUP per border
+ *    glyph and per text field, new = term.c back buffer + vt_move
+ *  - 2M mixed positions through ladder, vt_cup and tracked vt_move
+ *
+ * @date Jan. 3, 2026
+ * @author William Chung + Vanessa Guzman
+ */
+
+#include "vt100.h"
+#include "term.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define MOVES 2000000
+
+static uint32_t wire;                    // bytes term.c sent
+static char sink[64];
+
+uint16_t uart_tx_write(const char *buf, uint16_t len) {
+   (void) buf;
+   wire += len;
+   return len;
+}
+
+// removed cursor code, returns the bytes it would have printed
+static uint8_t ladder(char *a, uint8_t row, uint8_t col) {
+   uint8_t n = 0;
+   if (row >= 100 || col >= 200) {
+      return 0;
+   }
+   a[n++] = '\x1B';
+   a[n++] = '[';
+   if (row >= 10) {
+      a[n++] = (char) ('0' + (row / 10) % 10);
+   }
+   a[n++] = (char) ('0' + row % 10);
+   a[n++] = ';';
+   if (col >= 100) {
+      a[n++] = (char) ('0' + (col / 100) % 10);
+   }
+   if (col >= 10) {
+      a[n++] = (char) ('0' + (col / 10) % 10);
+   }
+   a[n++] = (char) ('0' + col % 10);
+   a[n++] = 'H';
+   return n;
+}
+
+/* leaderboard table, same cells as A8_ADC_Chart_Borders/LPUART_Chart_Words */
+
+static uint32_t old_bytes;
+
+static void old_fill(uint8_t row, uint8_t col, uint8_t cell, uint8_t n) {
+   for (uint8_t i = 0; i < n; i++) {
+      old_bytes += ladder(sink, row, col + i) + ((cell & 0x80) ? 3 : 1);
+   }
+}
+
+static void old_put(uint8_t row, uint8_t col, const char *s) {
+   old_bytes += ladder(sink, row, col) + strlen(s);
+}
+
+static void table(void (*fill)(uint8_t, uint8_t, uint8_t, uint8_t),
+      void (*put)(uint8_t, uint8_t, const char *)) {
+   char buf[8];
+
+   fill(12, 27, TERM_HORIZ, 24);
+   fill(36, 27, TERM_HORIZ, 24);
+   for (uint8_t r = 13; r <= 36; r++) {
+      fill(r, 27, TERM_VERT, 1);
+      fill(r, 51, TERM_VERT, 1);
+   }
+   fill(12, 27, TERM_TL, 1);
+   fill(12, 51, TERM_TR, 1);
+   fill(36, 27, TERM_BL, 1);
+   fill(36, 51, TERM_BR, 1);
+   for (uint8_t row = 14; row <= 36; row += 2) {
+      fill(row, 27, TERM_LT, 1);
+      fill(row, 28, TERM_HORIZ, 24);
+      fill(row, 51, TERM_RT, 1);
+   }
+   put(13, 29, "==LEADERBOARD==");
+   put(15, 29, "Rank");
+   put(15, 35, "Name");
+   put(15, 43, "Score");
+   for (uint8_t i = 0; i < 10; i++) {
+      snprintf(buf, sizeof(buf), "%-5u", i + 1);
+      put(17 + i * 2, 29, buf);
+      put(17 + i * 2, 35, "ABC");
+      snprintf(buf, sizeof(buf), "%5u", 9000 - i * 37);
+      put(17 + i * 2, 43, buf);
+   }
+}
+
+static double ns_per(clock_t t0, clock_t t1) {
+   return (double) (t1 - t0) * 1e9 / CLOCKS_PER_SEC / MOVES;
+}
+
+int main(void) {
+   volatile uint32_t total = 0;
+
+   table(old_fill, old_put);
+   term_clear();
+   wire = 0;
+   table(term_fill, term_put);
+   term_flush();
+   uint32_t new_bytes = wire;
+   wire = 0;
+   term_put(17, 43, " 9001");            // one changed score
+   term_flush();
+   printf("leaderboard table: old %u bytes, term+vt100 %u bytes, "
+         "one score after %u bytes\n", old_bytes, new_bytes, wire);
+
+   uint32_t b_ladder, b_cup;
+   VT_Cursor cur = { 0, 0 };
+   clock_t t0 = clock();
+   for (uint32_t i = 0; i < MOVES; i++) {
+      total += ladder(sink, 1 + i % 40, 1 + (i * 7) % 80);
+   }
+   clock_t t1 = clock();
+   b_ladder = total;
+   total = 0;
+   for (uint32_t i = 0; i < MOVES; i++) {
+      total += vt_cup(sink, 1 + i % 40, 1 + (i * 7) % 80);
+   }
+   clock_t t2 = clock();
+   b_cup = total;
+   total = 0;
+   for (uint32_t i = 0; i < MOVES; i++) {
+      total += vt_move(&cur, sink, 1 + i % 40, 1 + (i * 7) % 80);
+   }
+   clock_t t3 = clock();
+   printf("%-8s %8s %8s\n", "move", "ns/call", "bytes");
+   printf("%-8s %8.1f %8.2f\n", "ladder", ns_per(t0, t1),
+         (double) b_ladder / MOVES);
+   printf("%-8s %8.1f %8.2f\n", "vt_cup", ns_per(t1, t2),
+         (double) b_cup / MOVES);
+   printf("%-8s %8.1f %8.2f\n", "vt_move", ns_per(t2, t3),
+         (double) total / MOVES);
+   return 0;
+}
@@ -0,0 +1,389 @@
+/**
+ * @file test_eeprom.c
+ * @brief host tests for the leaderboard storage on the simulated 24LC256
+ *
+ *  - Save/load round trip through addScore, the journal and PS_drain
+ *  - Wear: worst page write count after many games
+ *  - Power cut at every byte of a save, commit byte included, and a torn
+ *    commit byte: boot must load the old or the new board, nothing else
+ *  - Power cut at every byte of a PS_service background flush with the
+ *    engine holding transfers, NACK burst on each of its page writes:
+ *    boot must load the last flushed board or a newer one
+ *  - Power cut between any two page writes of a rank store page split:
+ *    the table holds the old entries, with or without the new one, each
+ *    exactly once
+ *  - Fault injection: NACK bursts, stuck bus, dead bus at boot (no
+ *    migration, array untouched), failed flush keeps pages dirty
+ *  - Timing: simulated bus time of a full save (saveLeaderboard + cache
+ *    flush) and of a boot + loadLeaderboard at 100, 400 and 1000 kHz
+ *
+ * @date Jan. 3, 2026
+ * @author William Chung + Vanessa Guzman
+ */
+
+#include "EEPROM.h"
+#include "eeprom_sim.h"
+#include "eeprom_cache.h"
+#include "eeprom_log.h"
+#include "rank_store.h"
+#include "persist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GAMES 200
+
+#define CHECK(cond) do { \
+   if (!(cond)) { \
+      printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      failures++; \
+   } \
+} while (0)
+
+static int failures;
+static Player board[MAX_PLAYERS];
+static uint8_t snap[EE_SIM_SIZE];
+
+// what a reset does to RAM: the cache is gone, the driver starts over
+static void boot(void) {
+   EE_cache_invalidate();
+   EEPROM_init();
+}
+
+static uint8_t same(const Player *a, const Player *b, uint8_t n) {
+   for (uint8_t i = 0; i < n; i++) {
+      if (memcmp(a[i].name, b[i].name, NAME_LEN) || a[i].score != b[i].score) {
+         return 0;
+      }
+   }
+   return 1;
+}
+
+static uint8_t play(uint8_t n, int games) {
+   for (int i = 0; i < games; i++) {
+      char name[NAME_LEN] = { 'A' + i % 26, 'A' + (i / 26) % 26, 'X' };
+      n = addScore(board, n, name, rand() % 5000);
+      PS_drain();
+   }
+   return n;
+}
+
+static void test_round_trip(void) {
+   Player ref[MAX_PLAYERS];
+
+   EE_sim_reset();
+   boot();
+   uint8_t n = loadLeaderboard(board);
+   CHECK(n == 0);
+
+   n = play(n, GAMES);
+   CHECK(n == MAX_PLAYERS);
+   for (uint8_t i = 1; i < n; i++) {
+      CHECK(board[i - 1].score >= board[i].score);
+   }
+   memcpy(ref, board, sizeof(ref));
+
+   boot();
+   memset(board, 0, sizeof(board));
+   CHECK(loadLeaderboard(board) == n);
+   CHECK(same(board, ref, n));
+   RS_mount();
+   CHECK(RS_count() == GAMES);
+}
+
+static void test_wear(void) {
+   // every game appends to the journal and touches rank/profile pages;
+   // no page may take a write per game
+   CHECK(EE_sim_max_page_writes() < GAMES);
+   CHECK(EE_sim_page_writes(LB_COMMIT_ADDR / EEPROM_PAGE_SIZE) < GAMES / 4);
+}
+
+// power drops after cut bytes of one full save; 0 = lost before the bank
+static uint8_t crash_save(uint32_t cut, const Player *before,
+      const Player *after, uint8_t n) {
+   memcpy(board, after, sizeof(board));
+   EE_sim_power_cut_after(cut);
+   saveLeaderboard(board, n);
+   EE_cache_flush();
+   EE_sim_power_on();
+
+   boot();
+   memset(board, 0, sizeof(board));
+   uint8_t got = loadLeaderboard(board);
+   uint8_t ok = got == n && (same(board, before, n) || same(board, after, n));
+   memcpy(EE_sim_array(), snap, sizeof(snap));
+   return ok;
+}
+
+static void test_power_cut(void) {
+   Player before[MAX_PLAYERS], after[MAX_PLAYERS];
+
+   boot();
+   uint8_t n = loadLeaderboard(board);
+   memcpy(before, board, sizeof(before));
+   memcpy(after, board, sizeof(after));
+   after[0].score++;
+   memcpy(snap, EE_sim_array(), sizeof(snap));
+
+   // bytes one save puts on the part; the commit byte is the last of them
+   uint32_t w0 = EEPROM_get_stats()->bytes_written;
+   boot();
+   loadLeaderboard(board);
+   memcpy(board, after, sizeof(board));
+   saveLeaderboard(board, n);
+   EE_cache_flush();
+   uint32_t total = EEPROM_get_stats()->bytes_written - w0;
+   memcpy(EE_sim_array(), snap, sizeof(snap));
+   CHECK(total > 1);
+
+   int bad = 0;
+   for (uint32_t cut = 0; cut <= total; cut++) {
+      boot();
+      loadLeaderboard(board);
+      bad += !crash_save(cut, before, after, n);
+   }
+   CHECK(bad == 0);
+
+   // commit byte torn into garbage: the newest valid bank still wins
+   boot();
+   loadLeaderboard(board);
+   memcpy(board, after, sizeof(board));
+   saveLeaderboard(board, n);
+   EE_cache_flush();
+   for (uint8_t mask = 1; mask; mask <<= 1) {
+      uint8_t *mem = EE_sim_array();
+      uint8_t keep = mem[LB_COMMIT_ADDR];
+      EE_sim_flip(LB_COMMIT_ADDR, mask);
+      boot();
+      memset(board, 0, sizeof(board));
+      CHECK(loadLeaderboard(board) == n);
+      CHECK(same(board, before, n) || same(board, after, n));
+      mem[LB_COMMIT_ADDR] = keep;
+   }
+   memcpy(EE_sim_array(), snap, sizeof(snap));
+}
+
+// a score, a checkpoint and one more score go out through PS_service with
+// the engine in hold mode; the page write on the bus at step nack is
+// NACKed, power drops after cut bytes. Returns the bytes written, or
+// ~0 when boot found a board older than the one flushed before.
+static uint32_t crash_service(uint32_t cut, uint8_t nack) {
+   Player ok[3][MAX_PLAYERS];
+   uint8_t ok_n[3];
+
+   memcpy(EE_sim_array(), snap, sizeof(snap));
+   boot();
+   ok_n[0] = loadLeaderboard(board);
+   memcpy(ok[0], board, sizeof(board));
+   uint32_t w0 = EEPROM_get_stats()->bytes_written;
+   EE_sim_async_hold(1);
+   if (cut != ~0u) {
+      EE_sim_power_cut_after(cut);
+   }
+
+   uint8_t n = addScore(board, ok_n[0], "AAA", 4000);
+   saveLeaderboard(board, n);
+   ok_n[1] = n;
+   memcpy(ok[1], board, sizeof(board));
+   ok_n[2] = addScore(board, n, "BBB", 4100);
+   memcpy(ok[2], board, sizeof(board));
+   for (uint8_t i = 0; i < 64 && EE_sim_powered() && PS_pending(); i++) {
+      PS_service(1);
+      if (i == nack) {
+         EE_sim_fail_next(EEPROM_NACK, 255);
+      }
+      EE_sim_async_step();
+      EE_sim_fail_next(EEPROM_NACK, 0);
+   }
+   uint32_t written = EEPROM_get_stats()->bytes_written - w0;
+
+   EE_sim_async_hold(0);
+   EE_sim_power_on();
+   boot();
+   memset(board, 0, sizeof(board));
+   uint8_t got = loadLeaderboard(board);
+   for (uint8_t k = 0; k < 3; k++) {
+      if (got == ok_n[k] && same(board, ok[k], got)) {
+         return written;
+      }
+   }
+   return ~0u;
+}
+
+static void test_async_power_cut(void) {
+   EE_sim_reset();
+   boot();
+   uint8_t n = loadLeaderboard(board);
+   play(n, 20);                          // image + journal records, flushed
+   memcpy(snap, EE_sim_array(), sizeof(snap));
+
+   uint32_t total = crash_service(~0u, 0xFF);
+   CHECK(total != ~0u && total > 0);
+   int bad = 0;
+   for (uint8_t nack = 0; nack < 8; nack++) {
+      for (uint32_t cut = 0; cut <= total; cut++) {
+         bad += crash_service(cut, nack) == ~0u;
+      }
+   }
+   CHECK(bad == 0);
+   memcpy(EE_sim_array(), snap, sizeof(snap));
+}
+
+// full first page, then one score that splits it; 1 if after a cut
+// before page write cut the table reads back as the 12 old scores plus
+// maybe the new one
+static uint8_t crash_split(uint32_t cut, uint16_t score) {
+   Player out[RS_PER_PAGE + 2];
+
+   memcpy(EE_sim_array(), snap, sizeof(snap));
+   RS_mount();
+   EE_sim_power_cut_at_write(cut);
+   RS_insert("NEW", score);
+   EE_sim_power_on();
+
+   RS_mount();
+   uint16_t n = RS_read(0, out, RS_PER_PAGE + 2);
+   uint16_t old = 0, added = 0;
+   for (uint16_t i = 0; i < n; i++) {
+      if (i > 0 && out[i].score >= out[i - 1].score) {
+         return 0;                       // out of order or a duplicate
+      }
+      if (memcmp(out[i].name, "NEW", NAME_LEN) == 0) {
+         added++;
+      } else if (out[i].score % 100 == 0) {
+         old++;
+      }
+   }
+   // the directory count may lag a rewritten page by the new entry
+   return old == RS_PER_PAGE && added <= 1 && n == old + added
+         && (RS_count() == n || RS_count() + added == n);
+}
+
+static void test_split_cut(void) {
+   EE_sim_reset();
+   RS_mount();
+   for (uint16_t i = 1; i <= RS_PER_PAGE; i++) {
+      RS_insert("OLD", i * 100);
+   }
+   memcpy(snap, EE_sim_array(), sizeof(snap));
+
+   // 1150 lands in the upper half (stays in the old page), 150 in the
+   // lower half (goes to the new one)
+   static const uint16_t scores[] = { 1150, 150 };
+   for (uint8_t s = 0; s < 2; s++) {
+      uint32_t w0 = EEPROM_get_stats()->write_transactions;
+      RS_insert("NEW", scores[s]);
+      uint32_t total = EEPROM_get_stats()->write_transactions - w0;
+      int bad = 0;
+      for (uint32_t cut = 0; cut <= total; cut++) {
+         bad += !crash_split(cut, scores[s]);
+      }
+      CHECK(bad == 0);
+   }
+   memcpy(EE_sim_array(), snap, sizeof(snap));
+}
+
+static void test_faults(void) {
+   uint8_t b[4];
+   const EEPROM_Stats *s = EEPROM_get_stats();
+   Player good[MAX_PLAYERS];
+
+   // short NACK burst and a stuck bus are retried through
+   boot();
+   uint32_t retries = s->retries;
+   EE_sim_fail_next(EEPROM_NACK, 1);
+   CHECK(EEPROM_read_block(LB_BANK_A_ADDR, b, sizeof(b)) == EEPROM_OK);
+   CHECK(s->retries > retries);
+
+   uint32_t recoveries = s->bus_recoveries;
+   EE_sim_fail_next(EEPROM_TIMEOUT, 1);
+   CHECK(EEPROM_read_block(LB_BANK_A_ADDR, b, sizeof(b)) == EEPROM_OK);
+   CHECK(s->bus_recoveries > recoveries);
+
+   // dead bus at boot: no migration, nothing written, board back later
+   uint8_t n = loadLeaderboard(board);
+   memcpy(good, board, sizeof(good));
+   memcpy(snap, EE_sim_array(), sizeof(snap));
+   uint32_t load_errors = s->load_errors;
+   boot();
+   EE_sim_fail_next(EEPROM_NACK, 255);
+   CHECK(loadLeaderboard(board) == 0);
+   CHECK(s->load_errors == load_errors + 1);
+   addScore(board, 0, "ZZZ", 9999);
+   PS_drain();
+   EE_sim_fail_next(EEPROM_NACK, 0);
+   CHECK(memcmp(snap, EE_sim_array(), sizeof(snap)) == 0);
+   boot();
+   CHECK(loadLeaderboard(board) == n);
+   CHECK(same(board, good, n));
+
+   // failed flush: pages stay dirty and go out on the next one
+   board[1].score++;
+   memcpy(good, board, sizeof(good));
+   saveLeaderboard(board, n);
+   EE_sim_fail_next(EEPROM_NACK, 255);
+   CHECK(EE_cache_flush() != EEPROM_OK);
+   CHECK(EE_cache_dirty_pages() > 0);
+   EE_sim_fail_next(EEPROM_NACK, 0);
+   CHECK(EE_cache_flush() == EEPROM_OK);
+   CHECK(EE_cache_dirty_pages() == 0);
+   boot();
+   CHECK(loadLeaderboard(board) == n);
+   CHECK(same(board, good, n));
+
+   // bit rot in the live bank: CRC rejects it, the other bank loads
+   uint8_t *mem = EE_sim_array();
+   EE_sim_flip((mem[LB_COMMIT_ADDR] & 1) ? LB_BANK_B_ADDR + 20
+         : LB_BANK_A_ADDR + 20, 0x10);
+   boot();
+   CHECK(loadLeaderboard(board) == n);
+}
+
+// not pass/fail beyond the reload and a faster bus being faster: the
+// table is there to show what a save and a boot cost on the wire
+static void test_timing(void) {
+   static const uint16_t khz[] = { 100, 400, 1000 };
+   Player ref[MAX_PLAYERS];
+   uint64_t prev_save = ~0ull, prev_load = ~0ull;
+
+   printf("%-8s %12s %12s\n", "bus kHz", "save us", "load us");
+   for (uint8_t k = 0; k < sizeof(khz) / sizeof(khz[0]); k++) {
+      EE_sim_reset();
+      EE_sim_set_bus_khz(khz[k]);
+      boot();
+      uint8_t n = play(loadLeaderboard(board), 20);
+      EE_cache_flush();
+      memcpy(ref, board, sizeof(ref));
+
+      uint64_t t0 = EE_sim_time_us();
+      saveLeaderboard(board, n);
+      EE_cache_flush();
+      uint64_t t1 = EE_sim_time_us();
+      boot();
+      memset(board, 0, sizeof(board));
+      uint8_t loaded = loadLeaderboard(board);
+      uint64_t t2 = EE_sim_time_us();
+
+      CHECK(loaded == n && same(board, ref, n));
+      CHECK(t1 - t0 < prev_save && t2 - t1 < prev_load);
+      prev_save = t1 - t0;
+      prev_load = t2 - t1;
+      printf("%-8u %12llu %12llu\n", khz[k],
+            (unsigned long long) (t1 - t0), (unsigned long long) (t2 - t1));
+   }
+}
+
+int main(void) {
+   srand(1);
+   EEPROM_set_tier(EE_TIER_EXTERNAL);   // flash image would hide the part
+   test_round_trip();
+   test_wear();
+   test_power_cut();
+   test_async_power_cut();
+   test_split_cut();
+   test_faults();
+   test_timing();
+
+   printf("%s: %d failure(s)\n", failures ? "FAIL" : "PASS", failures);
+   return failures ? 1 : 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file test_rank.c
+ * @brief leaderboardRank/addScore against a reference sort
+ *
+ *  - Millions of random insertions into the top-10 board, each checked
+ *    entry by entry against a stable reference (highest score first,
+ *    ties keep arrival order, so the earlier player stays ahead)
+ *  - Score ranges alternate between narrow (many ties) and wide
+ *  - Internal flash tier only, so addScore stays in RAM; the persistence
+ *    queue is stubbed out, this test is about the ordering
+ *
+ * @date Jan. 3, 2026
+ * @author William Chung + Vanessa Guzman
+ */
+
+#include "EEPROM.h"
+#include "persist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRIALS      20000
+#define PER_TRIAL   100                  // 2M insertions in all
+
+// persist.c is not linked: the rank store/profile side is not under test
+void PS_queue_score(const char *name, uint16_t score) {
+   (void) name;
+   (void) score;
+}
+
+uint8_t PS_service(uint8_t idle) {
+   (void) idle;
+   return 0;
+}
+
+// reference: insert after every entry with a score >= score
+static uint8_t ref_insert(Player *ref, uint8_t n, const char *name,
+      uint16_t score) {
+   uint8_t pos = n;
+   while (pos > 0 && ref[pos - 1].score < score) {
+      pos--;
+   }
+   if (pos >= MAX_PLAYERS) {
+      return n;
+   }
+   if (n < MAX_PLAYERS) {
+      n++;
+   }
+   memmove(&ref[pos + 1], &ref[pos], (n - 1 - pos) * sizeof(Player));
+   memcpy(ref[pos].name, name, NAME_LEN);
+   ref[pos].score = score;
+   return n;
+}
+
+int main(void) {
+   Player board[MAX_PLAYERS];
+   Player ref[MAX_PLAYERS];
+   uint32_t checked = 0;
+
+   srand(1);
+   EEPROM_set_tier(EE_TIER_INTERNAL);
+   for (uint32_t trial = 0; trial < TRIALS; trial++) {
+      uint16_t range = (trial & 1) ? 20 : 60000;
+      uint8_t n = 0, rn = 0;
+
+      for (uint32_t k = 0; k < PER_TRIAL; k++) {
+         uint16_t score = rand() % range;
+         char name[NAME_LEN] = { 'A' + rand() % 26, 'A' + rand() % 26,
+               'A' + k % 26 };
+         uint8_t pos = leaderboardRank(board, n, score);
+         uint8_t rpos = 0;
+         while (rpos < rn && ref[rpos].score >= score) {
+            rpos++;
+         }
+         n = addScore(board, n, name, score);
+         rn = ref_insert(ref, rn, name, score);
+
+         if (pos != rpos || n != rn) {
+            printf("FAIL trial %u insert %u: rank %u/%u count %u/%u\n",
+                  trial, k, pos, rpos, n, rn);
+            return 1;
+         }
+         for (uint8_t i = 0; i < n; i++) {
+            if (board[i].score != ref[i].score
+                  || memcmp(board[i].name, ref[i].name, NAME_LEN)) {
+               printf("FAIL trial %u insert %u: slot %u\n", trial, k, i);
+               return 1;
+            }
+         }
+         checked++;
+      }
+   }
+   printf("PASS: %u insertions match the reference\n", checked);
+   return 0;
+}
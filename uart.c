@@ -23,14 +23,38 @@ uart.c
 ******************************************************************************
 * 10/22/2025      :	Created file
 * 11/25/2025      : Updated table as leaderboard
+* 12/19/2025      : Prints go through the DMA TX ring (uart_tx.c)
+* 12/20/2025      : Keys come from the RX interrupt ring (uart_rx.c)
+* 12/21/2025      : Leaderboard and title drawn through term.c shadow screen
+* 12/22/2025      : Cursor moves encoded by vt100.c
+* 12/23/2025      : Numbers and names formatted by fmt.c into the sink
+* 12/28/2025      : Keys handled on EV_KEY, waits run the event loop
+* 12/29/2025      : LPUART1 on HSI16 with wake from Stop 2
+* 12/30/2025      : Profiled LPUART_Print_string, C key dumps profile zones
 ******************************************************************************
 */
 
 #include "uart.h"
 #include "main.h"
 #include "EEPROM.h"
+#include "rank_store.h"
+#include "persist.h"
+#include "telemetry.h"
+#include "profile.h"
+#include "uart_tx.h"
+#include "uart_rx.h"
+#include "term.h"
+#include "vt100.h"
+#include "fmt.h"
+#include "evloop.h"
+#include "lowpower.h"
+#include "prof.h"
 //#include "delay.h"
 
+#define CHART_ROWS 10              // ranking rows that fit in the table
+
+static uint16_t chart_first = 0;   // 0-based rank shown on the first row
+
 /*
  * Function 1/5:  setup_LPUART1
  * ---------------------------------------------------------------------------
@@ -46,8 +70,11 @@ void UART_setup(void)
    PWR->CR2 |= (PWR_CR2_IOSV);              // power avail on PG[15:2] (LPUART1)
    RCC->AHB2ENR |= (RCC_AHB2ENR_GPIOGEN);   // enable GPIOG clock
    RCC->APB1ENR2 |= RCC_APB1ENR2_LPUART1EN; // enable LPUART clock bridge
+   RCC->CR |= RCC_CR_HSION;                 // HSI16 kernel clock, it is the
+   while (!(RCC->CR & RCC_CR_HSIRDY))       // one LPUART1 can wake from Stop 2
+      ;
    RCC ->CCIPR &= ~(RCC_CCIPR_LPUART1SEL_Msk);//used to select the correct clock
-   RCC ->CCIPR |= RCC_CCIPR_LPUART1SEL_0;
+   RCC ->CCIPR |= RCC_CCIPR_LPUART1SEL_1;
 
 
    /* USER: configure GPIOG registers MODER/PUPDR/OTYPER/OSPEEDR then
@@ -71,31 +98,31 @@ void UART_setup(void)
 
 
    LPUART1->CR1 &= ~(USART_CR1_M1 | USART_CR1_M0); // 8-bit data
+   LPUART1->CR1 |= USART_CR1_UESM;          // wake from Stop 2 on a key
+   LPUART1->CR3 |= USART_CR3_WUS;           // (RXNE), both need UE = 0
    LPUART1->CR1 |= USART_CR1_UE;                   // enable LPUART1
    LPUART1->CR1 |= (USART_CR1_TE | USART_CR1_RE);  // enable xmit & recv
    LPUART1->CR1 |= USART_CR1_RXNEIE;        // enable LPUART1 recv interrupt
    LPUART1->ISR &= ~(USART_ISR_RXNE);       // clear Recv-Not-Empty flag
    /* USER: set baud rate register (LPUART1->BRR) */
-   LPUART1->BRR = 0x115C7;
+   LPUART1->BRR = 0x115C7 * 4;              // same baud, 16 MHz vs 4 MHz
    NVIC->ISER[2] = (1 << (LPUART1_IRQn & 0x1F));   // enable LPUART1 ISR
+   uart_tx_init();                          // DMA2 CH6 drains the TX ring
    __enable_irq();                          // enable global interrupts
 }
 
 
 /************************************************************
  * Function: LPUART_Print()
- * Purpose : serial transmission using LPUART1 single character
+ * Purpose : serial transmission using LPUART1
  * Returns : None
- * Notes   : - sends one character at a time
+ * Notes   : - queues the string on the DMA TX ring and returns
 ************************************************************/
 void LPUART_Print( const char* message ) {
    uint16_t iStrIdx = 0;
-   while ( message[iStrIdx] != 0 ) {
-      while(!(LPUART1->ISR & USART_ISR_TXE)) // wait for empty xmit buffer
-         ;
-      LPUART1->TDR = message[iStrIdx];       // send this character
-      iStrIdx++;                             // advance index to next char
-   }
+   while ( message[iStrIdx] != 0 )
+      iStrIdx++;                             // find the end of the string
+   uart_tx_write(message, iStrIdx);
 }
 
 
@@ -106,35 +133,24 @@ void LPUART_Print( const char* message ) {
  * Purpose : Send string or sequence of characters of given length
  * Returns : None
  * Notes   : Used for formatted VT100 output or border drawing
+ *           Queued on the DMA TX ring, no longer waits for TC
+ *           (use uart_tx_flush() when the line must be on the wire)
  ************************************************************/
 void LPUART_Print_string(const char* s_message, int length){
-   /* used to send string one time through a for loop until null char*/
+   PROF_BEGIN(PROF_UART_PRINT);
+   /* used to send string one time until null char*/
    if (length == 0){
-      for (int i = 0; ; i++){
-         char c = s_message[i];
-         if (c == 0) break;
-         LPUART_wait_transmit();
-         LPUART1->TDR = (uint8_t)c;
-      }
-   } else {/*used for the horizontal printing of border, will iterate
-    *through length number of times*/
-     for (int i = 0; i < length; i++){
-        LPUART_wait_transmit();
-        LPUART1->TDR = (uint8_t)s_message[i];
-      }
+      LPUART_Print(s_message);
+   } else {/*used for the horizontal printing of border, will send
+    *length number of characters*/
+      uart_tx_write(s_message, (uint16_t)length);
    }
-   while (!(LPUART1->ISR & USART_ISR_TC)) {}
+   PROF_END(PROF_UART_PRINT);
 }
 void LPUART_ESC_Print(const char* esc_msg)
 {
-   LPUART_wait_transmit();
-   LPUART1 ->TDR = '\x1B';
-   for(int indx = 0; ;indx++){
-      if(esc_msg[indx] == 0)
-         break;
-      LPUART_wait_transmit();
-      LPUART1->TDR =esc_msg[indx];
-   }
+   uart_tx_write("\x1B", 1);
+   LPUART_Print(esc_msg);
 }
 
 
@@ -156,66 +172,14 @@ void LPUART_wait_transmit(void)
  * Function: LPUART_Set_Cursor_Location()
  * Purpose : Move VT100 cursor to specific row and column
  * Returns : None
- * Notes   : Builds escape code for cursor positioning
+ * Notes   : Any row/col; encoded by vt_cup straight into a
+ *           small buffer and queued on the TX ring. Absolute,
+ *           since other prints move the cursor untracked.
  ************************************************************/
-void LPUART_Set_Cursor_Location(uint8_t row, uint8_t col)
+void LPUART_Set_Cursor_Location(uint16_t row, uint16_t col)
 {
-   //array position for the values row and col less than 10
-   if(row<10 && col<10){
-      //create char array to feed to print string
-      char cursor_move_2_2[] = {'\x1B', '[',row+0x30, ';',col+0x30, 'H', 0x00};
-      LPUART_Print_string(cursor_move_2_2,0);
-   }
-   //array position  row less than 10 column less than 100
-   else if(row<10 && col<100){
-      /*sort tens and ones position for each row to create proper array
-       * for cursor location placement*/
-      char ten_col = (char)('0' + ((col / 10) % 10));
-      char one_col = (char)('0' + (col % 10));
-      //create char array to feed to print string
-      char cursor_move_2_2[] = {'\x1B', '[',row+0x30, ';',
-            ten_col,one_col, 'H', 0x00};
-      LPUART_Print_string(cursor_move_2_2,0);
-   }
-   //array position row less than 10 column less than 200
-   else if(row<10 && col<200){
-      /*sort tens and ones position for each row to create proper array
-       * for cursor location placement*/
-      char hun_col = (char)('0' + ((col / 100) % 10));
-      char ten_col = (char)('0' + ((col / 10)  % 10));
-      char one_col = (char)('0' + (col % 10));
-      //create char array to feed to print string
-      char cursor_move_2_2[] = {'\x1B', '[',row+0x30, ';',
-            hun_col,ten_col,one_col, 'H', 0x00};
-      LPUART_Print_string(cursor_move_2_2,0);
-   }
-   //array position row less than 100 column less than 100
-   else if(row<100 && col<100){//used for maximized window setting
-      /*sort tens and ones position for each row to create proper array
-       * for cursor location placement*/
-      char ten_row = (char)('0' + ((row / 10) % 10));
-      char one_row = (char)('0' + (row % 10));
-      char ten_col = (char)('0' + ((col / 10) % 10));
-      char one_col = (char)('0' + (col % 10));
-      //create char array to feed to print string
-      char cursor_move_2_2[] = {'\x1B', '[',ten_row,one_row,
-            ';',ten_col,one_col, 'H', 0x00};
-      LPUART_Print_string(cursor_move_2_2,0);
-   }
-   //array position row less than 100 column less than 200
-   else if(row<100 && col<200){ //used for maximized window setting
-      /*sort tens and ones position for each row and hundred,tens,ones for
-       * column location to create proper array for cursor location placement*/
-      char ten_row = (char)('0' + ((row / 10) % 10));
-      char one_row = (char)('0' + (row % 10));
-      char hun_col = (char)('0' + ((col / 100) % 10));
-      char ten_col = (char)('0' + ((col / 10)  % 10));
-      char one_col = (char)('0' + (col % 10));
-      //create char array to feed to print string
-      char cursor_move_2_2[] = {'\x1B', '[',ten_row,one_row,
-            ';',hun_col,ten_col,one_col, 'H', 0x00};
-      LPUART_Print_string(cursor_move_2_2,0);
-   }
+   char seq[VT_MAX_SEQ];
+   uart_tx_write(seq, vt_cup(seq, row, col));
 }
 
 /*
@@ -278,44 +242,21 @@ void LPUART_Set_Cursor_Location(uint8_t row, uint8_t col)
  */
 void LPUART1_Game_Setup(void) {
    // Move cursor down 3 lines and right 5 spaces
-	LPUART_ESC_Print("[2J");
-	LPUART_ESC_Print("[H");
-
-	LPUART_Set_Cursor_Location(10, 10);
-	LPUART_Print_string("           ___________________________          ", 0);
-
-	LPUART_Set_Cursor_Location(11, 10);
-	LPUART_Print_string("         /\\                         /\\         ", 0);
-
-	LPUART_Set_Cursor_Location(12, 10);
-	LPUART_Print_string("        /  \\        *FLASH*        /  \\        ", 0);
-
-	LPUART_Set_Cursor_Location(13, 10);
-	LPUART_Print_string("       / /\\ \\                    / /\\ \\       ", 0);
-
-	LPUART_Set_Cursor_Location(14, 10);
-	LPUART_Print_string("      / /__\\ \\    REACTIONX     / /__\\ \\      ", 0);
-
-	LPUART_Set_Cursor_Location(15, 10);
-	LPUART_Print_string("     /_/____\\_\\_______________ /_/____\\_\\     ", 0);
-
-	LPUART_Set_Cursor_Location(16, 10);
-	LPUART_Print_string("     \\ \\    / /   TEST YOUR    \\ \\    / /     ", 0);
-
-	LPUART_Set_Cursor_Location(17, 10);
-	LPUART_Print_string("      \\ \\  / /   REFLEX SPEED   \\ \\  / /      ", 0);
-
-	LPUART_Set_Cursor_Location(18, 10);
-	LPUART_Print_string("       \\ \\/ /                    \\ \\/ /       ", 0);
-
-	LPUART_Set_Cursor_Location(19, 10);
-	LPUART_Print_string("        \\  /    > PRESS START <    \\  /        ", 0);
-
-	LPUART_Set_Cursor_Location(20, 10);
-	LPUART_Print_string("         \\/ _______________________ \\/         ", 0);
-
-	LPUART_Set_Cursor_Location(21, 10);
-	LPUART_Print_string("            Cal Poly E329 - Team LEDZ         ", 0);
+	term_clear();
+
+	term_put(10, 10, "           ___________________________          ");
+	term_put(11, 10, "         /\\                         /\\         ");
+	term_put(12, 10, "        /  \\        *FLASH*        /  \\        ");
+	term_put(13, 10, "       / /\\ \\                    / /\\ \\       ");
+	term_put(14, 10, "      / /__\\ \\    REACTIONX     / /__\\ \\      ");
+	term_put(15, 10, "     /_/____\\_\\_______________ /_/____\\_\\     ");
+	term_put(16, 10, "     \\ \\    / /   TEST YOUR    \\ \\    / /     ");
+	term_put(17, 10, "      \\ \\  / /   REFLEX SPEED   \\ \\  / /      ");
+	term_put(18, 10, "       \\ \\/ /                    \\ \\/ /       ");
+	term_put(19, 10, "        \\  /    > PRESS START <    \\  /        ");
+	term_put(20, 10, "         \\/ _______________________ \\/         ");
+	term_put(21, 10, "            Cal Poly E329 - Team LEDZ         ");
+	term_flush();               // blanks in the art are not sent
 
 
 //
@@ -333,43 +274,173 @@ void LPUART1_Game_Setup(void) {
 
 }
 
-void waitForStart(void)
+//streams one telemetry page as CSV lines: level,outcome,ms ms ms...
+//returns 0 once the whole ring has been sent
+static uint8_t telemetry_export_step(void)
 {
-    LPUART_Print("\r\nPress any key to start...\r\n");
+    static const char outcome[] = { 'P', 'W', 'T', '?' };
+    static TLM_Round rounds[EEPROM_PAGE_SIZE / 3]; //smallest record, 3 bytes
 
-    // Wait until a character is received
-    while (!(LPUART1->ISR & USART_ISR_RXNE));
-    (void)LPUART1->RDR; // read it (doesn’t matter what key)
-    LPUART_ESC_Print("[2J");
-    LPUART_ESC_Print("[H");
+    uint8_t n = TLM_export_next(rounds, sizeof(rounds) / sizeof(rounds[0]));
+    if (n == TLM_EXPORT_DONE) {
+        LPUART_Print("end\r\n");
+        return 0;
+    }
+    for (uint8_t i = 0; i < n; i++) {
+        uart_printf("%u,%c,", rounds[i].level, outcome[rounds[i].outcome & 3]);
+        for (uint8_t j = 0; j < rounds[i].presses; j++)
+            uart_printf("%u ", rounds[i].react_ms[j]);
+        LPUART_Print("\r\n");
+    }
+    return 1;
+}
 
+// Keys are handled by the EV_KEY handler below, the prompts just run the
+// event loop until it marks them done. The handler drains the whole ring,
+// so a byte whose event was dropped on a full queue is still taken.
+typedef enum {
+    KEYS_IGNORE = 0,                    // left in the ring for later
+    KEYS_START,                         // waitForStart menu
+    KEYS_INITIALS                       // pollInitials letters
+} KeyMode;
+
+static KeyMode key_mode;
+static uint8_t key_done;
+static uint8_t key_count;               // initials typed so far
+static uint8_t exporting;               // telemetry dump in progress
+static char *initials;
+
+// waitForStart menu: command keys act in place, any other key starts
+static void start_key(char c)
+{
+#ifdef PROF_ENABLE
+    if (c == 'c' || c == 'C') {
+        prof_dump();
+        return;
+    }
+#endif
+    if (c == 'n' || c == 'N' || c == 'b' || c == 'B') {
+        LPUART_Chart_Scroll((c == 'n' || c == 'N') ? 1 : -1);
+        return;
+    }
+    if (c == 'p' || c == 'P') {
+        uart_printf("run %.1u%%  sleep %.1u%%  stop2 %.1u%%\r\n",
+                pm_residency(PM_RUN), pm_residency(PM_SLEEP),
+                pm_residency(PM_STOP2));
+        return;
+    }
+    if (c != 't' && c != 'T') {
+        key_done = 1;        // any other key starts the game
+        return;
+    }
+    TLM_export_begin();
+    LPUART_Print("level,outcome,reaction_ms\r\n");
+    exporting = 1;
 }
 
-void getInitials(char *name)
+// initials: only A-Z is accepted, backspace takes a letter back
+static void initials_key(char c)
+{
+    if ((c == '\b' || c == 0x7F) && key_count > 0)
+    {
+        key_count--;
+        LPUART_Print("\b \b");
+    }
+    // Only accept A–Z
+    else if (c >= 'A' && c <= 'Z')
+    {
+        initials[key_count++] = c;
+        LPUART_Print_string(&c, 1); // echo character back to terminal
+    }
+    if (key_count == 3)
+        key_done = 1;
+}
+
+static void take_keys(void)
 {
-    uint8_t count = 0;
     char c;
 
-    LPUART_Print("\r\nEnter your initials (3 letters): ");
+    while (key_mode != KEYS_IGNORE && !key_done && uart_getc(&c)) {
+        if (key_mode == KEYS_START)
+            start_key(c);
+        else
+            initials_key(c);
+    }
+}
 
-    while (count < 3)
-    {
-        // Wait until data is received
-        while (!(LPUART1->ISR & USART_ISR_RXNE));
-        c = LPUART1->RDR;  // read received byte
+static void on_key(const EV_Event *ev)
+{
+    take_keys();
+}
 
-        // Only accept A–Z
-        if (c >= 'A' && c <= 'Z')
-        {
-            name[count++] = c;
-            LPUART1->TDR = c; // echo character back to terminal
-            while (!(LPUART1->ISR & USART_ISR_TXE));
+void uart_keys_init(void)
+{
+    ev_on(EV_KEY, on_key);
+}
 
+void waitForStart(void)
+{
+    uart_rx_clear();         // keys mashed during the last game
+    LPUART_Print("\r\nPress any key to start "
+            "(T = dump telemetry, P = power modes, "
+            "N/B = next/previous leaderboard page)...\r\n");
+
+    // Wait until a starting key is handled, the event loop persists queued
+    // scores while idle and sleeps until EV_KEY; a telemetry dump streams
+    // a page per pass if one was asked for
+    exporting = 0;
+    key_done = 0;
+    key_mode = KEYS_START;
+    while (!key_done) {
+        if (exporting) {
+            exporting = telemetry_export_step();
+            ev_poll();
+        } else {
+            ev_run_once();
         }
     }
+    key_mode = KEYS_IGNORE;
+    term_clear();
+
+}
+
+// Non-blocking initials entry: the first call opens the prompt, EV_KEY
+// fills name while the caller keeps the event loop running (its LED
+// animation can go on between passes), returns 1 once 3 letters are in
+uint8_t pollInitials(char *name)
+{
+    if (key_mode != KEYS_INITIALS) {
+        initials = name;
+        key_count = 0;
+        key_done = 0;
+        key_mode = KEYS_INITIALS;
+        take_keys();                    // typed before the prompt opened
+    }
+    if (!key_done)
+        return 0;
+    key_mode = KEYS_IGNORE;             // ready for the next player
+    return 1;
+}
+
+void getInitials(char *name)
+{
+    LPUART_Print("\r\nEnter your initials (3 letters): ");
+
+    // waiting on a person, the event loop persists queued scores meanwhile
+    while (!pollInitials(name))
+        ev_run_once();
 
     // No null terminator needed if NAME_LEN = 3
     LPUART_Print("\r\n");
+
+    // returning player: one hashed bucket read finds their profile
+    Profile p;
+    if (PF_lookup(name, &p)) {
+        uart_printf("Welcome back! Personal best: %u  Games: %u\r\n",
+                p.best, p.games);
+    } else {
+        LPUART_Print("New player, good luck!\r\n");
+    }
 }
 
 
@@ -379,6 +450,9 @@ void getInitials(char *name)
  * Purpose : Draw formatted ADC data table on terminal
  * Returns : None
  * Notes   : Calls helper functions to draw borders and labels
+ *           into the shadow screen; only cells that differ from
+ *           what the terminal shows are sent, so calling it again
+ *           after addScore() sends just the changed rows
  ************************************************************/
 void A8_Extra_Credit_Table(void)
 {
@@ -387,6 +461,7 @@ void A8_Extra_Credit_Table(void)
    LPUART_Draw_Corners();
    LPUART_Draw_Inner_Ends();
    LPUART_Chart_Words();
+   term_flush();
 }
 
 
@@ -399,23 +474,16 @@ void A8_Extra_Credit_Table(void)
 void A8_ADC_Chart_Borders(void)
 {
     // Top border (row 12)
-    LPUART_ESC_Print("[12;27H");
-    for (int i = 0; i < 24; i++)
-        LPUART_Print_string("\xE2\x95\x90", 0);
+    term_fill(12, 27, TERM_HORIZ, 24);
 
     // Bottom border (row 36)
-    LPUART_ESC_Print("[36;27H");
-    for (int i = 0; i < 24; i++)
-        LPUART_Print_string("\xE2\x95\x90", 0);
+    term_fill(36, 27, TERM_HORIZ, 24);
 
     // Vertical borders
     for (uint8_t r = 13; r <= 36; r++)
     {
-        LPUART_Set_Cursor_Location(r, 27);  // left border
-        LPUART_Print_string("\xE2\x95\x91", 0);
-
-        LPUART_Set_Cursor_Location(r, 51);  // right border
-        LPUART_Print_string("\xE2\x95\x91", 0);
+        term_fill(r, 27, TERM_VERT, 1);  // left border
+        term_fill(r, 51, TERM_VERT, 1);  // right border
     }
 }
 
@@ -429,22 +497,10 @@ void A8_ADC_Chart_Borders(void)
  ************************************************************/
 void LPUART_Draw_Corners(void)
 {
-    const char *TL = "\xE2\x95\x94";
-    const char *TR = "\xE2\x95\x97";
-    const char *BL = "\xE2\x95\x9A";
-    const char *BR = "\xE2\x95\x9D";
-
-    LPUART_Set_Cursor_Location(12, 27);
-    LPUART_Print_string(TL, 0);
-
-    LPUART_Set_Cursor_Location(12, 51);
-    LPUART_Print_string(TR, 0);
-
-    LPUART_Set_Cursor_Location(36, 27);
-    LPUART_Print_string(BL, 0);
-
-    LPUART_Set_Cursor_Location(36, 51);
-    LPUART_Print_string(BR, 0);
+    term_fill(12, 27, TERM_TL, 1);
+    term_fill(12, 51, TERM_TR, 1);
+    term_fill(36, 27, TERM_BL, 1);
+    term_fill(36, 51, TERM_BR, 1);
 }
 
 
@@ -459,35 +515,10 @@ void LPUART_Draw_Inner_Ends(void)
     // Separators at rows 15, 17, 19, 21, 23
     for (uint8_t row = 14; row <= 36; row += 2)
     {
-        LPUART_Set_Cursor_Location(row, 27);
-        LPUART_Print_string("\xE2\x95\xA0", 0);  // ╠
-
-        for (int i = 0; i < 24; i++)
-            LPUART_Print_string("\xE2\x95\x90", 0);  // ═
-
-        LPUART_Set_Cursor_Location(row, 51);
-        LPUART_Print_string("\xE2\x95\xA3", 0);  // ╣
-    }
-}
-
-//converts int to string value to be used by Print_string()
-void uint_to_str(uint16_t value, char *buf)
-{
-    char temp[6];    // temporary backwards buffer
-    uint8_t idx = 0;
-
-    // Extract digits in reverse order
-    do {
-        temp[idx++] = (value % 10) + '0';  // convert digit to ASCII
-        value /= 10;
-    } while (value > 0);
-
-    // Reverse into the output buffer
-    for (uint8_t i = 0; i < idx; i++) {
-        buf[i] = temp[idx - 1 - i];
+        term_fill(row, 27, TERM_LT, 1);      // ╠
+        term_fill(row, 28, TERM_HORIZ, 24);  // ═
+        term_fill(row, 51, TERM_RT, 1);      // ╣
     }
-
-    buf[idx] = 0;  // null terminator — MAKE IT A STRING
 }
 
 
@@ -497,48 +528,50 @@ void uint_to_str(uint16_t value, char *buf)
  * Purpose : Print text labels inside ADC chart
  * Returns : None
  * Notes   : Places labels such as “ADC”, “Counts”, and “Volts”
+ *           Rows come from the all-time rank store, CHART_ROWS at a
+ *           time starting at chart_first (see LPUART_Chart_Scroll)
  ************************************************************/
 void LPUART_Chart_Words(void)
 {
 /*This code will fill in the table with the measurement names needed*/
-   LPUART_Set_Cursor_Location(13,29);
-   LPUART_Print_string("==LEADERBOARD==",0);
-   LPUART_Set_Cursor_Location(15,29);
-   LPUART_Print_string("Rank",0);
-   LPUART_Set_Cursor_Location(15,35);
-   LPUART_Print_string("Name",0);
-   LPUART_Set_Cursor_Location(15,43);
-   LPUART_Print_string("Score",0);
-   uint8_t count = 10;
-   uint8_t i;
-   for(i=0; i<count; i++){
-	   char buf[6];
-	   uint_to_str(i+1, buf);      // manual number→string function
-	   LPUART_Set_Cursor_Location(17 + (i*2), 29);
-	   LPUART_Print_string(buf, 0); //print rankings 1-10
-	   char name_str[4];
-
-	   //print initials
-	   name_str[0] = leaderboard[i].name[0];
-	   name_str[1] = leaderboard[i].name[1];
-	   name_str[2] = leaderboard[i].name[2];
-	   name_str[3] = 0;               // null-terminate
-	   LPUART_Set_Cursor_Location(17 + (i*2), 35);
-	   LPUART_Print_string(name_str, 0);
-
-	   //print scores
-	   uint_to_str(leaderboard[i].score, buf);   // convert score → string
-	   LPUART_Set_Cursor_Location(17 + (i*2), 43);
-	   LPUART_Print_string(buf, 0);
+   term_put(13,29,"==LEADERBOARD==");
+   term_put(15,29,"Rank");
+   term_put(15,35,"Name");
+   term_put(15,43,"Score");
 
+   Player rows[CHART_ROWS];
+   uint8_t count = RS_read(chart_first, rows, CHART_ROWS);
+   uint8_t i;
+   for(i=0; i<CHART_ROWS; i++){
+	   // padded fields so a shorter value clears the old one
+	   if (i < count) {
+		   term_printf(17 + (i*2), 29, "%-5u", chart_first + i + 1); //rank
+		   term_printf(17 + (i*2), 35, "%-3.3s", rows[i].name);      //initials
+		   term_printf(17 + (i*2), 43, "%-5u", rows[i].score);       //score
+	   } else {
+		   // past the last entry: blank row
+		   term_fill(17 + (i*2), 29, ' ', 5);
+		   term_fill(17 + (i*2), 35, ' ', 3);
+		   term_fill(17 + (i*2), 43, ' ', 5);
+	   }
    }
-
-
 }
 
-
-
-
-
-
-
+/************************************************************
+ * Function: LPUART_Chart_Scroll()
+ * Purpose : Move the leaderboard view by whole pages of CHART_ROWS
+ * Returns : None
+ * Notes   : Clamped to the first/last page, redraws only the words
+ ************************************************************/
+void LPUART_Chart_Scroll(int8_t pages)
+{
+   int32_t first = (int32_t)chart_first + (int32_t)pages * CHART_ROWS;
+   int32_t total = RS_count();
+   if (first > total - 1)
+      first = ((total - 1) / CHART_ROWS) * CHART_ROWS;
+   if (first < 0)
+      first = 0;
+   chart_first = (uint16_t)first;
+   LPUART_Chart_Words();
+   term_flush();
+}
@@ -38,17 +38,19 @@ void LPUART_Print( const char* message );
 void LPUART_Print_string(const char* s_message, int length);
 void LPUART_ESC_Print(const char* esc_msg);
 void LPUART_wait_transmit(void);
-void LPUART_Set_Cursor_Location(uint8_t row, uint8_t col);
+void LPUART_Set_Cursor_Location(uint16_t row, uint16_t col);
 void draw_border(void);
 void LPUART1_Game_Setup(void);
+void uart_keys_init(void);
 void waitForStart(void);
+uint8_t pollInitials(char *name);
 void getInitials(char *name);
 void A8_Extra_Credit_Table(void);
 void A8_ADC_Chart_Borders(void);
 void LPUART_Draw_Corners(void);
 void LPUART_Draw_Inner_Ends(void);
-void uint_to_str(uint16_t value, char *buf);
 void LPUART_Chart_Words(void);
+void LPUART_Chart_Scroll(int8_t pages);
 
 
 #endif // UART_H
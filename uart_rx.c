@@ -0,0 +1,142 @@
+/*
+------------------------------------------------------------------------------
+uart_rx.c
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 uart_rx.c
+******************************************************************************
+* @file           : uart_rx.c
+* @brief          : interrupt-driven LPUART1 receive ring and line editor
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/20/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2
+* wiring       	  : PG8 as RX
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/20/2025      :	Created file
+* 12/28/2025      :	Received bytes also post EV_KEY
+******************************************************************************
+*/
+
+#include "uart_rx.h"
+#include "uart.h"
+#include "evloop.h"
+
+// single producer (ISR writes head) / single consumer (main loop writes
+// tail), so neither side needs to mask interrupts
+static char ring[UART_RX_RING_SIZE];
+static volatile uint8_t head;
+static volatile uint8_t tail;
+static UART_RxStats rx_stats;
+
+/*
+ * Function 1: LPUART1_IRQHandler
+ * --------------------
+ * RXNE (enabled in UART_setup): move the byte into the ring
+ *    ORE is cleared and counted so reception keeps going
+ *
+ *	takes in: nothing
+ *
+ *  returns: nothing
+ */
+void LPUART1_IRQHandler(void) {
+   uint32_t isr = LPUART1->ISR;
+
+   if (isr & USART_ISR_ORE) {
+      LPUART1->ICR = USART_ICR_ORECF;
+      rx_stats.overruns++;
+   }
+   if (isr & USART_ISR_RXNE) {
+      char c = (char) LPUART1->RDR;
+      uint8_t next = head + 1;
+      rx_stats.received++;
+      if (next == tail) {
+         rx_stats.dropped++;
+      } else {
+         ring[head] = c;
+         head = next;
+      }
+      ev_post(EV_KEY, (uint8_t) c);
+   }
+}
+
+/*
+ * Function 2: uart_getc
+ * --------------------
+ * takes the oldest received byte, never waits
+ *
+ *	takes in: c - receives the byte
+ *
+ *  returns: 1 = byte read, 0 = ring empty
+ */
+uint8_t uart_getc(char *c) {
+   if (head == tail) {
+      return 0;
+   }
+   *c = ring[tail];
+   tail = tail + 1;
+   return 1;
+}
+
+uint8_t uart_rx_available(void) {
+   return (uint8_t) (head - tail);
+}
+
+// drop anything typed so far (e.g. keys mashed during a round)
+void uart_rx_clear(void) {
+   tail = head;
+}
+
+void uart_line_init(UART_Line *line, char *buf, uint8_t size) {
+   line->buf = buf;
+   line->size = size;
+   line->len = 0;
+   buf[0] = 0;
+}
+
+/*
+ * Function 3: uart_readline
+ * --------------------
+ * non-blocking line editor: consumes what has arrived, echoes printable
+ *    characters, backspace/DEL erases, Enter ends the line
+ *
+ *	takes in: line - editor state from uart_line_init
+ *
+ *  returns: 1 = line complete (buf is 0-terminated), 0 = still typing
+ */
+uint8_t uart_readline(UART_Line *line) {
+   char c;
+
+   while (uart_getc(&c)) {
+      if (c == '\r' || c == '\n') {
+         line->buf[line->len] = 0;
+         LPUART_Print("\r\n");
+         return 1;
+      }
+      if (c == '\b' || c == 0x7F) {
+         if (line->len) {
+            line->len--;
+            LPUART_Print("\b \b");    // rub out on the terminal
+         }
+         continue;
+      }
+      if (c >= ' ' && c <= '~' && line->len < line->size - 1) {
+         line->buf[line->len++] = c;
+         LPUART_Print_string(&c, 1);
+      }
+   }
+   line->buf[line->len] = 0;
+   return 0;
+}
+
+const UART_RxStats *uart_rx_get_stats(void) {
+   return &rx_stats;
+}
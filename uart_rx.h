@@ -0,0 +1,59 @@
+/*
+------------------------------------------------------------------------------
+uart_rx.h
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 uart_rx.h
+******************************************************************************
+* @file           : uart_rx.h
+* @brief          : header for uart_rx.c (interrupt-driven LPUART1 receive)
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/20/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2
+* wiring       	  : PG8 as RX
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/20/2025      :	Created file
+******************************************************************************
+*/
+
+// ----------------------------------------------- #includes for uart_rx.c --
+#ifndef UART_RX_H
+#define UART_RX_H
+
+#include "stm32l4xx_hal.h"
+#include <stdint.h>
+
+#define UART_RX_RING_SIZE 256       // uint8_t indexes wrap on their own
+
+typedef struct {
+   uint32_t received;               // bytes taken from RDR
+   uint32_t overruns;               // ORE: a byte was lost in hardware
+   uint32_t dropped;                // ring full, byte thrown away
+} UART_RxStats;
+
+// line editor state, one per line being typed
+typedef struct {
+   char *buf;
+   uint8_t size;                    // including the terminating 0
+   uint8_t len;
+} UART_Line;
+
+// ---------- Function Prototypes --------------------------------------------
+uint8_t uart_getc(char *c);
+uint8_t uart_rx_available(void);
+void uart_rx_clear(void);
+void uart_line_init(UART_Line *line, char *buf, uint8_t size);
+uint8_t uart_readline(UART_Line *line);
+const UART_RxStats *uart_rx_get_stats(void);
+void LPUART1_IRQHandler(void);
+
+#endif // UART_RX_H
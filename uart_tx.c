@@ -0,0 +1,201 @@
+/*
+------------------------------------------------------------------------------
+uart_tx.c
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 uart_tx.c
+******************************************************************************
+* @file           : uart_tx.c
+* @brief          : DMA-driven LPUART1 transmit ring
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/19/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2
+* wiring       	  : PG7 as TX (DMA2 CH6, request 4)
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/19/2025      :	Created file
+* 12/29/2025      :	uart_tx_idle() for the Stop 2 check
+******************************************************************************
+*/
+
+#include "uart_tx.h"
+
+#define TX_MASK      (UART_TX_RING_SIZE - 1)
+#define TX_DMA       DMA2_Channel6
+#define TX_DMA_REQ   4u              // CxS value for LPUART1_TX on DMA2 CH6
+
+static char ring[UART_TX_RING_SIZE];
+static volatile uint16_t head;       // next free byte (print side)
+static volatile uint16_t tail;       // next byte to send (DMA side)
+static volatile uint16_t dma_len;    // bytes in the running transfer
+static UART_TxPolicy tx_policy = UART_TX_BLOCK;
+static UART_TxStats tx_stats;
+
+/*
+ * Function 1: kick
+ * --------------------
+ * starts a DMA transfer of the contiguous bytes at tail if none is running
+ *    call with the DMA interrupt masked (or from it)
+ *
+ *	takes in: nothing
+ *
+ *  returns: nothing
+ */
+static void kick(void) {
+   if (dma_len || head == tail) {
+      return;
+   }
+   uint16_t n = (head > tail) ? head - tail : UART_TX_RING_SIZE - tail;
+   dma_len = n;
+   TX_DMA->CCR = 0;
+   TX_DMA->CMAR = (uint32_t) &ring[tail];
+   TX_DMA->CNDTR = n;
+   TX_DMA->CCR = DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_TCIE | DMA_CCR_TEIE
+         | DMA_CCR_EN;
+   tx_stats.dma_runs++;
+}
+
+static inline uint16_t used(void) {
+   return (head - tail) & TX_MASK;
+}
+
+/*
+ * Function 2: uart_tx_init
+ * --------------------
+ * DMA2 CH6 -> LPUART1_TX, memory to peripheral, TC interrupt
+ *    called by UART_setup() after LPUART1 is enabled
+ *
+ *	takes in: nothing
+ *
+ *  returns: nothing
+ */
+void uart_tx_init(void) {
+   RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;
+
+   DMA2_CSELR->CSELR &= ~DMA_CSELR_C6S;
+   DMA2_CSELR->CSELR |= (TX_DMA_REQ << DMA_CSELR_C6S_Pos);
+
+   TX_DMA->CCR = 0;
+   TX_DMA->CPAR = (uint32_t) &LPUART1->TDR;
+   LPUART1->CR3 |= USART_CR3_DMAT;
+
+   NVIC_SetPriority(DMA2_Channel6_IRQn, 4);
+   NVIC_EnableIRQ(DMA2_Channel6_IRQn);
+}
+
+void uart_tx_set_policy(UART_TxPolicy policy) {
+   tx_policy = policy;
+}
+
+uint16_t uart_tx_free(void) {
+   return TX_MASK - used();
+}
+
+/*
+ * Function 3: uart_tx_write
+ * --------------------
+ * copies len bytes into the ring and returns; the DMA sends them
+ *    in the background. A message that does not fit follows tx_policy.
+ *
+ *	takes in: buf, len
+ *
+ *  returns: bytes accepted
+ */
+uint16_t uart_tx_write(const char *buf, uint16_t len) {
+   uint16_t done = 0;
+   uint16_t room = uart_tx_free();
+
+   if (len > room) {
+      if (tx_policy == UART_TX_DROP) {
+         tx_stats.dropped += len;
+         return 0;
+      }
+      if (tx_policy == UART_TX_TRUNCATE) {
+         tx_stats.dropped += len - room;
+         len = room;
+      } else {
+         tx_stats.blocked++;
+      }
+   }
+
+   while (done < len) {
+      room = uart_tx_free();
+      if (room == 0) {
+         continue;                   // BLOCK: DMA interrupt frees space
+      }
+      uint16_t n = len - done;
+      if (n > room) {
+         n = room;
+      }
+      for (uint16_t i = 0; i < n; i++) {
+         ring[(head + i) & TX_MASK] = buf[done + i];
+      }
+      done += n;
+
+      NVIC_DisableIRQ(DMA2_Channel6_IRQn);
+      head = (head + n) & TX_MASK;
+      kick();
+      NVIC_EnableIRQ(DMA2_Channel6_IRQn);
+
+      uint16_t u = used();
+      if (u > tx_stats.max_used) {
+         tx_stats.max_used = u;
+      }
+   }
+   tx_stats.queued += done;
+   return done;
+}
+
+/*
+ * Function 4: uart_tx_flush
+ * --------------------
+ * waits until every queued byte has left the shift register
+ *
+ *	takes in: nothing
+ *
+ *  returns: nothing
+ */
+void uart_tx_flush(void) {
+   while (head != tail || dma_len) {
+   }
+   while (!(LPUART1->ISR & USART_ISR_TC)) {
+   }
+}
+
+// 1 = nothing queued, no DMA run, last stop bit sent (safe to Stop 2)
+uint8_t uart_tx_idle(void) {
+   return head == tail && !dma_len && (LPUART1->ISR & USART_ISR_TC);
+}
+
+const UART_TxStats *uart_tx_get_stats(void) {
+   return &tx_stats;
+}
+
+/*
+ * Function 5: DMA2_Channel6_IRQHandler
+ * --------------------
+ * transfer complete: release the sent bytes and start on the next run
+ *
+ *	takes in: nothing
+ *
+ *  returns: nothing
+ */
+void DMA2_Channel6_IRQHandler(void) {
+   uint32_t isr = DMA2->ISR;
+
+   if (isr & (DMA_ISR_TCIF6 | DMA_ISR_TEIF6)) {
+      DMA2->IFCR = DMA_IFCR_CGIF6;
+      TX_DMA->CCR = 0;
+      tail = (tail + dma_len) & TX_MASK;   // on an error the run is skipped
+      dma_len = 0;
+      kick();
+   }
+}
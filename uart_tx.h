@@ -0,0 +1,63 @@
+/*
+------------------------------------------------------------------------------
+uart_tx.h
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 uart_tx.h
+******************************************************************************
+* @file           : uart_tx.h
+* @brief          : header for uart_tx.c (DMA-driven LPUART1 transmit)
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/19/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2
+* wiring       	  : PG7 as TX (DMA2 CH6, request 4)
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/19/2025      :	Created file
+* 12/29/2025      :	uart_tx_idle()
+******************************************************************************
+*/
+
+// ----------------------------------------------- #includes for uart_tx.c --
+#ifndef UART_TX_H
+#define UART_TX_H
+
+#include "stm32l4xx_hal.h"
+#include <stdint.h>
+
+#define UART_TX_RING_SIZE 2048      // power of two
+
+// what uart_tx_write does when the message does not fit in the ring
+typedef enum {
+   UART_TX_BLOCK = 0,               // wait for the DMA to make room
+   UART_TX_DROP,                    // drop the whole message
+   UART_TX_TRUNCATE                 // keep what fits, drop the rest
+} UART_TxPolicy;
+
+typedef struct {
+   uint32_t queued;                 // bytes accepted into the ring
+   uint32_t dropped;                // bytes lost to DROP/TRUNCATE
+   uint32_t blocked;                // writes that had to wait for room
+   uint32_t dma_runs;               // DMA transfers started
+   uint16_t max_used;               // high-water mark of the ring
+} UART_TxStats;
+
+// ---------- Function Prototypes --------------------------------------------
+void uart_tx_init(void);
+void uart_tx_set_policy(UART_TxPolicy policy);
+uint16_t uart_tx_write(const char *buf, uint16_t len);
+uint16_t uart_tx_free(void);
+void uart_tx_flush(void);
+uint8_t uart_tx_idle(void);
+const UART_TxStats *uart_tx_get_stats(void);
+void DMA2_Channel6_IRQHandler(void);
+
+#endif // UART_TX_H
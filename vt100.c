@@ -0,0 +1,172 @@
+/*
+------------------------------------------------------------------------------
+vt100.c
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 vt100.c
+******************************************************************************
+* @file           : vt100.c
+* @brief          : VT100 escape encoder: cursor moves, SGR, clears
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/22/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2
+* wiring       	  : n/a
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/22/2025      :	Created file
+******************************************************************************
+*/
+
+#include "vt100.h"
+
+// final byte and the parameter value the terminal assumes when it is
+// left out, so that value is never sent
+static const struct {
+   char final;
+   uint8_t dflt;
+} vt_ops[VT_OP_COUNT] = {
+   [VT_CUU] = { 'A', 1 },
+   [VT_CUD] = { 'B', 1 },
+   [VT_CUF] = { 'C', 1 },
+   [VT_CUB] = { 'D', 1 },
+   [VT_ED]  = { 'J', 0 },
+   [VT_EL]  = { 'K', 0 },
+   [VT_SGR] = { 'm', 0 },
+};
+
+static inline uint8_t num_len(uint16_t n) {
+   return 1 + (n >= 10) + (n >= 100) + (n >= 1000) + (n >= 10000);
+}
+
+// decimal n into buf, returns the digit count
+static uint8_t put_num(char *buf, uint16_t n) {
+   uint8_t len = num_len(n);
+   for (uint8_t i = len; i > 0; i--) {
+      buf[i - 1] = '0' + n % 10;
+      n /= 10;
+   }
+   return len;
+}
+
+/*
+ * Function 1: vt_csi
+ * --------------------
+ * encodes ESC [ n <final> for op into buf, n left out when it is the
+ *    default for that sequence
+ *
+ *	takes in: buf (VT_MAX_SEQ bytes), op, n
+ *
+ *  returns: bytes written
+ */
+uint8_t vt_csi(char *buf, VT_Op op, uint16_t n) {
+   uint8_t len = 0;
+   buf[len++] = '\x1B';
+   buf[len++] = '[';
+   if (n != vt_ops[op].dflt)
+      len += put_num(&buf[len], n);
+   buf[len++] = vt_ops[op].final;
+   return len;
+}
+
+uint8_t vt_csi_len(VT_Op op, uint16_t n) {
+   return 3 + (n != vt_ops[op].dflt ? num_len(n) : 0);
+}
+
+// ESC [ row ; col H, ESC [ row H when col is 1, ESC [ H for home
+uint8_t vt_cup(char *buf, uint16_t row, uint16_t col) {
+   uint8_t len = 0;
+   buf[len++] = '\x1B';
+   buf[len++] = '[';
+   if (row != 1 || col != 1) {
+      len += put_num(&buf[len], row);
+      if (col != 1) {
+         buf[len++] = ';';
+         len += put_num(&buf[len], col);
+      }
+   }
+   buf[len++] = 'H';
+   return len;
+}
+
+uint8_t vt_cup_len(uint16_t row, uint16_t col) {
+   if (row == 1 && col == 1)
+      return 3;
+   return 3 + num_len(row) + (col != 1 ? 1 + num_len(col) : 0);
+}
+
+// horizontal part of a relative move: CUF, CUB or CR (+CUF)
+static uint8_t col_len(uint16_t from, uint16_t to, uint8_t *use_cr) {
+   *use_cr = 0;
+   if (to == from)
+      return 0;
+   if (to > from)
+      return vt_csi_len(VT_CUF, to - from);
+   uint8_t cr = 1 + (to > 1 ? vt_csi_len(VT_CUF, to - 1) : 0);
+   uint8_t cub = vt_csi_len(VT_CUB, from - to);
+   *use_cr = (cr < cub);
+   return *use_cr ? cr : cub;
+}
+
+/*
+ * Function 2: vt_move
+ * --------------------
+ * writes the shortest sequence that takes the cursor from cur to
+ *    row, col: CUP, or CUU/CUD plus CUF/CUB/CR when cur is known.
+ *    cur is updated; nothing is written if already there.
+ *
+ *	takes in: cur, buf (VT_MAX_SEQ bytes), row, col (1-based)
+ *
+ *  returns: bytes written
+ */
+uint8_t vt_move(VT_Cursor *cur, char *buf, uint16_t row, uint16_t col) {
+   uint8_t len = 0;
+
+   if (cur->row == row && cur->col == col)
+      return 0;
+
+   if (cur->row && cur->col) {
+      uint8_t use_cr;
+      uint8_t rel = col_len(cur->col, col, &use_cr);
+      if (row != cur->row)
+         rel += vt_csi_len(row > cur->row ? VT_CUD : VT_CUU,
+               row > cur->row ? row - cur->row : cur->row - row);
+      if (rel < vt_cup_len(row, col)) {
+         if (row > cur->row)
+            len += vt_csi(&buf[len], VT_CUD, row - cur->row);
+         else if (row < cur->row)
+            len += vt_csi(&buf[len], VT_CUU, cur->row - row);
+         if (use_cr) {
+            buf[len++] = '\r';
+            if (col > 1)
+               len += vt_csi(&buf[len], VT_CUF, col - 1);
+         } else if (col > cur->col) {
+            len += vt_csi(&buf[len], VT_CUF, col - cur->col);
+         } else if (col < cur->col) {
+            len += vt_csi(&buf[len], VT_CUB, cur->col - col);
+         }
+         cur->row = row;
+         cur->col = col;
+         return len;
+      }
+   }
+   cur->row = row;
+   cur->col = col;
+   return vt_cup(buf, row, col);
+}
+
+// clear screen and home: ESC[2J ESC[H
+uint8_t vt_clear(VT_Cursor *cur, char *buf) {
+   uint8_t len = vt_csi(buf, VT_ED, VT_ED_ALL);
+   len += vt_cup(&buf[len], 1, 1);
+   cur->row = 1;
+   cur->col = 1;
+   return len;
+}
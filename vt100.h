@@ -0,0 +1,68 @@
+/*
+------------------------------------------------------------------------------
+vt100.h
+------------------------------------------------------------------------------
+* USER CODE BEGIN Header
+******************************************************************************
+* EE 329 vt100.h
+******************************************************************************
+* @file           : vt100.h
+* @brief          : header for vt100.c (VT100 escape sequence encoder)
+* project         : EE 329 Final Project
+* authors         : Vanessa G
+* version         : 1
+* date            : 12/22/2025
+* compiler        : STM32CubeIDE v.1.19.0
+* target          : NUCLEO-L4A6ZG
+* clocks          : 4 MHz MSI to AHB2
+* wiring       	  : n/a
+* attachment	  : n/a
+* @attention      : (c) 2023 STMicroelectronics.  All rights reserved.
+******************************************************************************
+* REVISION HISTORY
+******************************************************************************
+* 12/22/2025      :	Created file
+******************************************************************************
+*/
+
+// ------------------------------------------------- #includes for vt100.c --
+#ifndef VT100_H
+#define VT100_H
+
+#include <stdint.h>
+
+#define VT_MAX_SEQ 16               // room for any vt_move/vt_clear output
+
+// one-parameter CSI sequences, encoded from a table in vt100.c
+typedef enum {
+   VT_CUU = 0,                      // cursor up n
+   VT_CUD,                          // cursor down n
+   VT_CUF,                          // cursor forward n
+   VT_CUB,                          // cursor back n
+   VT_ED,                           // erase display, 2 = whole screen
+   VT_EL,                           // erase line, 0 = to end of line
+   VT_SGR,                          // attribute: 0 reset, 30-37 fg, 40-47 bg
+   VT_OP_COUNT
+} VT_Op;
+
+#define VT_ED_ALL   2
+#define VT_SGR_RESET 0
+#define VT_SGR_BOLD 1
+#define VT_SGR_FG(c) (30 + (c))     // c = 0 black .. 7 white
+#define VT_SGR_BG(c) (40 + (c))
+
+// where the terminal cursor is, 1-based; row 0 = unknown
+typedef struct {
+   uint16_t row;
+   uint16_t col;
+} VT_Cursor;
+
+// ---------- Function Prototypes --------------------------------------------
+uint8_t vt_csi(char *buf, VT_Op op, uint16_t n);
+uint8_t vt_csi_len(VT_Op op, uint16_t n);
+uint8_t vt_cup(char *buf, uint16_t row, uint16_t col);
+uint8_t vt_cup_len(uint16_t row, uint16_t col);
+uint8_t vt_move(VT_Cursor *cur, char *buf, uint16_t row, uint16_t col);
+uint8_t vt_clear(VT_Cursor *cur, char *buf);
+
+#endif // VT100_H